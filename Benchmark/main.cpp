@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EntityManager.hpp"
+#include "InputRecording.hpp"
+#include "JobSystem.hpp"
+#include "Replay.hpp"
+#include "Simulation.hpp"
+#include "StateHash.hpp"
+#include "StressScene.hpp"
+
+// Replays recorded runs (Runner --record) without a window and reports, per recording,
+// the simulation speed, the tick time distribution and the final state hash.
+// Exits with 1 if a replay does not end in its recorded state, or ends differently
+// from one repetition to the next: CI checks performance and determinism at once.
+// Levels are loaded from levels/, run it from the Runner directory.
+//
+// --scaling runs a synthetic headless scene (100k entities by default) with the job
+// system on 1, 2, 4... up to every hardware thread, and reports the speedup of each
+// thread count over the single-threaded path. Exits with 1 if one of them does not
+// end in the single-threaded state.
+//
+// Usage: Benchmark [--repeat <count>] <run.rrec>...
+//        Benchmark --scaling [--entities <count>] [--ticks <count>] [--threads <max>]
+namespace
+{
+    // Same as Game
+    const sf::Vector2u LOGICAL_RESOLUTION = { 1920, 1080 };
+
+    constexpr std::uint32_t SCALING_SEED = 0x5CA1E;
+    constexpr int SCALING_WARMUP_TICKS = 10;
+    // Average distance between entities: about one overlapping neighbour each
+    constexpr float SCALING_SPACING = 120.f;
+
+    bool benchmarkRecording(const std::string& filePath, int repeatCount)
+    {
+        const InputRecording recording = loadInputRecording(filePath);
+
+        ReplayResult total;
+        bool isDeterministic = true;
+        for (int repeat = 0; repeat < repeatCount; ++repeat)
+        {
+            ReplayResult result = replayRecording(recording, LOGICAL_RESOLUTION, true);
+            if (repeat > 0 && result.finalStateHash != total.finalStateHash)
+                isDeterministic = false;
+
+            total.tickCount += result.tickCount;
+            total.runCount = result.runCount;
+            total.seconds += result.seconds;
+            total.finalStateHash = result.finalStateHash;
+            total.tickMilliseconds.insert(total.tickMilliseconds.end(), result.tickMilliseconds.begin(), result.tickMilliseconds.end());
+        }
+
+        const TickTimeSummary tickTimes = summarizeTickTimes(total.tickMilliseconds);
+        const bool isMatching = total.matches(recording);
+
+        std::cout << filePath << ": " << recording.inputs.size() << " ticks x" << repeatCount << ", " << total.runCount << " runs, "
+                  << std::fixed << std::setprecision(0) << total.getTicksPerSecond() << " ticks/s, "
+                  << std::setprecision(4) << "tick p50 " << tickTimes.p50 << " ms, p99 " << tickTimes.p99 << " ms, max " << tickTimes.max << " ms, "
+                  << "hash " << std::hex << std::setw(16) << std::setfill('0') << total.finalStateHash << std::dec << std::setfill(' ')
+                  << (!isDeterministic ? " NOT DETERMINISTIC" : !isMatching ? " MISMATCH" : " OK") << std::endl;
+
+        return isDeterministic && isMatching;
+    }
+
+    // One thread count's run of the stress scene
+    struct ScalingResult
+    {
+        double ticksPerSecond;
+        std::uint64_t stateHash;
+    };
+
+    ScalingResult runScalingScene(int entityCount, int tickCount, unsigned int threadCount)
+    {
+        using Clock = std::chrono::steady_clock;
+
+        JobSystem jobSystem(threadCount);
+        EntityManager entityManager;
+        spawnStressScene(entityManager, SCALING_SEED, entityCount, SCALING_SPACING);
+        // One thread: the plain single-threaded path, the reference
+        entityManager.setJobSystem(threadCount > 1 ? &jobSystem : nullptr);
+
+        auto tick = [&entityManager]
+        {
+            entityManager.updateAll(Simulation::TICK_DURATION);
+            entityManager.updateColisions();
+        };
+
+        for (int i = 0; i < SCALING_WARMUP_TICKS; ++i)
+            tick();
+
+        const Clock::time_point start = Clock::now();
+        for (int i = 0; i < tickCount; ++i)
+            tick();
+        const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        StateHash hash;
+        entityManager.hashState(hash);
+        return { seconds > 0.0 ? tickCount / seconds : 0.0, hash.getValue() };
+    }
+
+    bool benchmarkScaling(int entityCount, int tickCount, unsigned int maxThreadCount)
+    {
+        std::vector<unsigned int> threadCounts;
+        for (unsigned int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+            threadCounts.push_back(threadCount);
+        threadCounts.push_back(maxThreadCount);
+
+        std::cout << "Scaling: " << entityCount << " entities, " << tickCount << " ticks" << std::endl;
+
+        bool isDeterministic = true;
+        ScalingResult reference{};
+        for (const unsigned int threadCount : threadCounts)
+        {
+            const ScalingResult result = runScalingScene(entityCount, tickCount, threadCount);
+            if (threadCount == 1)
+                reference = result;
+            const bool isMatching = result.stateHash == reference.stateHash;
+            isDeterministic = isDeterministic && isMatching;
+
+            std::cout << std::setw(3) << threadCount << (threadCount == 1 ? " thread:  " : " threads: ")
+                      << std::fixed << std::setprecision(1) << result.ticksPerSecond << " ticks/s, "
+                      << std::setprecision(3) << (result.ticksPerSecond > 0.0 ? 1000.0 / result.ticksPerSecond : 0.0) << " ms/tick, "
+                      << std::setprecision(2) << "x" << (reference.ticksPerSecond > 0.0 ? result.ticksPerSecond / reference.ticksPerSecond : 0.0) << ", "
+                      << "hash " << std::hex << std::setw(16) << std::setfill('0') << result.stateHash << std::dec << std::setfill(' ')
+                      << (isMatching ? " OK" : " NOT DETERMINISTIC") << std::endl;
+        }
+        return isDeterministic;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int repeatCount = 1;
+    bool isScaling = false;
+    int entityCount = 100'000;
+    int tickCount = 300;
+    unsigned int maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::string> filePaths;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--repeat" && i + 1 < argc)
+            repeatCount = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--scaling")
+            isScaling = true;
+        else if (argument == "--entities" && i + 1 < argc)
+            entityCount = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--ticks" && i + 1 < argc)
+            tickCount = std::max(1, std::atoi(argv[++i]));
+        else if (argument == "--threads" && i + 1 < argc)
+            maxThreadCount = static_cast<unsigned int>(std::max(1, std::atoi(argv[++i])));
+        else
+            filePaths.push_back(argument);
+    }
+
+    if (isScaling)
+        return benchmarkScaling(entityCount, tickCount, maxThreadCount) ? 0 : 1;
+
+    if (filePaths.empty())
+    {
+        std::cerr << "Usage: Benchmark [--repeat <count>] <run.rrec>...\n"
+                  << "       Benchmark --scaling [--entities <count>] [--ticks <count>] [--threads <max>]" << std::endl;
+        return 2;
+    }
+
+    bool isSuccess = true;
+    for (const std::string& filePath : filePaths)
+    {
+        try
+        {
+            isSuccess = benchmarkRecording(filePath, repeatCount) && isSuccess;
+        }
+        catch (const std::exception& exception)
+        {
+            std::cerr << filePath << ": " << exception.what() << std::endl;
+            isSuccess = false;
+        }
+    }
+    return isSuccess ? 0 : 1;
+}
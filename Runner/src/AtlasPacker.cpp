@@ -0,0 +1,41 @@
+#include "AtlasPacker.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+AtlasLayout packAtlas(const std::vector<sf::Vector2u>& imageSizes, unsigned int maxWidth, unsigned int padding)
+{
+    std::vector<std::size_t> order(imageSizes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&imageSizes](std::size_t a, std::size_t b) {
+        return imageSizes[a].y > imageSizes[b].y;
+    });
+
+    AtlasLayout layout;
+    layout.regions.resize(imageSizes.size());
+
+    sf::Vector2u cursor = { padding, padding };
+    unsigned int shelfHeight = 0;
+    for (const std::size_t index : order)
+    {
+        const sf::Vector2u size = imageSizes[index];
+        if (size.x + 2 * padding > maxWidth)
+            throw std::length_error("packAtlas: image wider than the atlas");
+
+        if (cursor.x + size.x + padding > maxWidth)
+        {
+            cursor = { padding, cursor.y + shelfHeight + padding };
+            shelfHeight = 0;
+        }
+
+        layout.regions[index] = sf::IntRect(static_cast<sf::Vector2i>(cursor), static_cast<sf::Vector2i>(size));
+        layout.size.x = std::max(layout.size.x, cursor.x + size.x + padding);
+        layout.size.y = std::max(layout.size.y, cursor.y + size.y + padding);
+
+        cursor.x += size.x + padding;
+        shelfHeight = std::max(shelfHeight, size.y);
+    }
+
+    return layout;
+}
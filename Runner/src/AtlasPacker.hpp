@@ -0,0 +1,18 @@
+#pragma once
+
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+// Where each image goes inside the atlas, and the atlas size.
+struct AtlasLayout
+{
+    sf::Vector2u size;
+    std::vector<sf::IntRect> regions; // same order as the image sizes given to packAtlas()
+};
+
+// Shelf packing: images are placed by decreasing height, left to right, opening a new
+// shelf when the current one is full. Padding is kept around each image so that
+// texture filtering never samples a neighbour.
+AtlasLayout packAtlas(const std::vector<sf::Vector2u>& imageSizes, unsigned int maxWidth = 2048, unsigned int padding = 1);
@@ -0,0 +1,53 @@
+#include "BinaryLevelFormat.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "TextLevelSource.hpp"
+
+void writeBinaryLevel(LevelChunkSource& source, const std::filesystem::path& filePath)
+{
+    const int chunkCount = source.getChunkCount();
+
+    std::vector<BinaryChunkIndexEntry> chunkIndex;
+    std::vector<LevelEntityRecord> records;
+    std::vector<LevelEntityRecord> chunkRecords;
+    chunkIndex.reserve(static_cast<std::size_t>(chunkCount));
+
+    for (int i = 0; i < chunkCount; ++i)
+    {
+        source.readChunk(i, chunkRecords);
+        if (records.size() + chunkRecords.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("writeBinaryLevel: too many entities");
+
+        chunkIndex.push_back({ static_cast<std::uint32_t>(records.size()), static_cast<std::uint32_t>(chunkRecords.size()) });
+        records.insert(records.end(), chunkRecords.begin(), chunkRecords.end());
+    }
+
+    BinaryLevelHeader header{};
+    std::copy(std::begin(BINARY_LEVEL_MAGIC), std::end(BINARY_LEVEL_MAGIC), header.magic);
+    header.version = BINARY_LEVEL_VERSION;
+    header.levelUID = source.getLevelUID();
+    header.chunkWidth = source.getChunkWidth();
+    header.chunkCount = static_cast<std::uint32_t>(chunkCount);
+    header.entityCount = static_cast<std::uint32_t>(records.size());
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("writeBinaryLevel: cannot create " + filePath.string());
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(chunkIndex.data()), static_cast<std::streamsize>(chunkIndex.size() * sizeof(BinaryChunkIndexEntry)));
+    file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(records.size() * sizeof(LevelEntityRecord)));
+    if (!file.flush())
+        throw std::runtime_error("writeBinaryLevel: cannot write " + filePath.string());
+}
+
+void compileLevel(const std::filesystem::path& textFilePath, const std::filesystem::path& binaryFilePath)
+{
+    TextLevelSource source(textFilePath);
+    writeBinaryLevel(source, binaryFilePath);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+
+#include "LevelData.hpp"
+
+// Binary level format (.rlvl), little-endian, meant to be memory-mapped:
+//
+//     BinaryLevelHeader
+//     BinaryChunkIndexEntry[chunkCount]
+//     LevelEntityRecord[entityCount]    (grouped by chunk, in chunk order)
+//
+// Every field is 4 bytes wide, so the records are correctly aligned wherever the
+// mapping starts. Bump BINARY_LEVEL_VERSION whenever the layout changes.
+
+constexpr char BINARY_LEVEL_MAGIC[4] = { 'R', 'L', 'V', 'L' };
+constexpr std::uint32_t BINARY_LEVEL_VERSION = 1;
+
+struct BinaryLevelHeader
+{
+    char magic[4];
+    std::uint32_t version;
+    std::int32_t levelUID;
+    float chunkWidth;
+    std::uint32_t chunkCount;
+    std::uint32_t entityCount;
+};
+static_assert(sizeof(BinaryLevelHeader) == 24, "BinaryLevelHeader is a file format record");
+
+// The chunk's records are records[firstEntity, firstEntity + entityCount)
+struct BinaryChunkIndexEntry
+{
+    std::uint32_t firstEntity;
+    std::uint32_t entityCount;
+};
+static_assert(sizeof(BinaryChunkIndexEntry) == 8, "BinaryChunkIndexEntry is a file format record");
+
+static_assert(std::endian::native == std::endian::little, "Binary levels are read in place, they must match the file's byte order");
+
+// Writes every chunk of source into a binary level file. Throws on failure.
+void writeBinaryLevel(LevelChunkSource& source, const std::filesystem::path& filePath);
+
+// Converts a text level (see TextLevelSource) into a binary level
+void compileLevel(const std::filesystem::path& textFilePath, const std::filesystem::path& binaryFilePath);
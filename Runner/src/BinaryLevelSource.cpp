@@ -0,0 +1,59 @@
+#include "BinaryLevelSource.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+BinaryLevelSource::BinaryLevelSource(const std::filesystem::path& filePath)
+    : m_file(filePath)
+{
+    const std::string error = "BinaryLevelSource: " + filePath.string();
+    const std::byte* data = m_file.getData();
+    const std::size_t size = m_file.getSize();
+
+    if (size < sizeof(BinaryLevelHeader))
+        throw std::runtime_error(error + " is truncated");
+    std::memcpy(&m_header, data, sizeof(BinaryLevelHeader));
+
+    if (!std::equal(std::begin(BINARY_LEVEL_MAGIC), std::end(BINARY_LEVEL_MAGIC), m_header.magic))
+        throw std::runtime_error(error + " is not a binary level");
+    if (m_header.version != BINARY_LEVEL_VERSION)
+    {
+        throw std::runtime_error(error + " has version " + std::to_string(m_header.version)
+            + ", expected " + std::to_string(BINARY_LEVEL_VERSION) + " (recompile it from the text level)");
+    }
+    if (m_header.levelUID < 0 || !(m_header.chunkWidth > 0.f))
+        throw std::runtime_error(error + " has an invalid header");
+
+    const std::size_t indexOffset = sizeof(BinaryLevelHeader);
+    const std::size_t recordsOffset = indexOffset + std::size_t{ m_header.chunkCount } * sizeof(BinaryChunkIndexEntry);
+    const std::size_t expectedSize = recordsOffset + std::size_t{ m_header.entityCount } * sizeof(LevelEntityRecord);
+    if (size != expectedSize)
+        throw std::runtime_error(error + " is truncated");
+
+    // Everything in the file is 4-byte aligned and the mapping is page aligned
+    m_chunkIndex = { reinterpret_cast<const BinaryChunkIndexEntry*>(data + indexOffset), m_header.chunkCount };
+    m_records = { reinterpret_cast<const LevelEntityRecord*>(data + recordsOffset), m_header.entityCount };
+
+    for (const BinaryChunkIndexEntry& chunk : m_chunkIndex)
+    {
+        if (chunk.firstEntity > m_records.size() || chunk.entityCount > m_records.size() - chunk.firstEntity)
+            throw std::runtime_error(error + " has a chunk out of bounds");
+    }
+}
+
+void BinaryLevelSource::readChunk(int chunkIndex, std::vector<LevelEntityRecord>& entities)
+{
+    const std::span<const LevelEntityRecord> records = viewChunk(chunkIndex);
+    entities.assign(records.begin(), records.end());
+}
+
+std::span<const LevelEntityRecord> BinaryLevelSource::viewChunk(int chunkIndex) const
+{
+    if (chunkIndex < 0 || chunkIndex >= getChunkCount())
+        throw std::out_of_range("BinaryLevelSource: no chunk " + std::to_string(chunkIndex));
+
+    const BinaryChunkIndexEntry& chunk = m_chunkIndex[static_cast<std::size_t>(chunkIndex)];
+    return m_records.subspan(chunk.firstEntity, chunk.entityCount);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "BinaryLevelFormat.hpp"
+#include "LevelData.hpp"
+#include "MappedFile.hpp"
+
+// Reads a binary level (see BinaryLevelFormat.hpp) through a memory mapping.
+// Opening only validates the header and the chunk index; the records are used
+// in place and paged in by the OS when a chunk is first spawned.
+class BinaryLevelSource : public LevelChunkSource
+{
+public:
+    // Throws if the file cannot be mapped or is not a valid binary level
+    explicit BinaryLevelSource(const std::filesystem::path& filePath);
+
+    int getLevelUID() const override { return m_header.levelUID; }
+    float getChunkWidth() const override { return m_header.chunkWidth; }
+    int getChunkCount() const override { return static_cast<int>(m_chunkIndex.size()); }
+
+    void readChunk(int chunkIndex, std::vector<LevelEntityRecord>& entities) override;
+
+    bool canViewChunks() const override { return true; }
+    std::span<const LevelEntityRecord> viewChunk(int chunkIndex) const override;
+
+private:
+    MappedFile m_file;
+    BinaryLevelHeader m_header{};
+    std::span<const BinaryChunkIndexEntry> m_chunkIndex;
+    std::span<const LevelEntityRecord> m_records;
+};
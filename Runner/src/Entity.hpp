@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <SFML/Graphics/Rect.hpp>
+
+// Entities are not objects anymore: their data lives in the EntityManager's arrays
+// and the outside world only keeps an EntityHandle to refer to one of them.
+
+enum class EntityType : std::uint8_t
+{
+    Player,
+    Spike,
+    MovingEnemy,
+    Projectile,
+    Collectible,
+    Count
+};
+
+constexpr std::size_t ENTITY_TYPE_COUNT = static_cast<std::size_t>(EntityType::Count);
+
+// The entityUID given to EntityManager::spawnEntity() and written in level files
+constexpr int entityUIDOf(EntityType type)
+{
+    return static_cast<int>(type);
+}
+
+enum class EntityState : std::uint8_t
+{
+    Alive,
+    Dead
+};
+
+// Generational handle: the generation is bumped every time a slot is freed,
+// so a handle to a destroyed entity can never reach the entity reusing its slot.
+struct EntityHandle
+{
+    static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+    std::uint32_t index = INVALID_INDEX;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return index != INVALID_INDEX; }
+
+    bool operator==(const EntityHandle&) const = default;
+};
+
+// Narrow phase test shared by every system (strict: touching edges do not collide).
+// Cheaper than sf::Rect::findIntersection when the intersection itself is not needed.
+inline bool isColliding(const sf::FloatRect& hitbox, const sf::FloatRect& otherHitbox)
+{
+    return hitbox.position.x < otherHitbox.position.x + otherHitbox.size.x
+        && otherHitbox.position.x < hitbox.position.x + hitbox.size.x
+        && hitbox.position.y < otherHitbox.position.y + otherHitbox.size.y
+        && otherHitbox.position.y < hitbox.position.y + hitbox.size.y;
+}
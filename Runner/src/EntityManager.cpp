@@ -0,0 +1,352 @@
+#include "EntityManager.hpp"
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+#include "StateHash.hpp"
+
+namespace
+{
+    struct EntityArchetype
+    {
+        EntityType type;
+        sf::Vector2f size;
+        sf::Vector2f velocity;
+        int health;
+    };
+
+    // Indexed by entityUID
+    constexpr std::array<EntityArchetype, ENTITY_TYPE_COUNT> ARCHETYPES = { {
+        { EntityType::Player,      { 64.f, 64.f }, { 0.f, 0.f },    3 },
+        { EntityType::Spike,       { 64.f, 64.f }, { 0.f, 0.f },    1 },
+        { EntityType::MovingEnemy, { 64.f, 64.f }, { -150.f, 0.f }, 1 },
+        { EntityType::Projectile,  { 32.f, 16.f }, { -600.f, 0.f }, 1 },
+        { EntityType::Collectible, { 32.f, 32.f }, { 0.f, 0.f },    1 },
+    } };
+
+    constexpr float HUGE_COORDINATE = 1.0e30f;
+
+    // Entities per updateAll() job: a few hundred KB of components, enough to outweigh scheduling
+    constexpr std::size_t UPDATE_BATCH_SIZE = 4096;
+}
+
+EntityManager::EntityManager()
+    : m_activeArea({ -HUGE_COORDINATE, -HUGE_COORDINATE }, { 2.f * HUGE_COORDINATE, 2.f * HUGE_COORDINATE })
+{
+}
+
+void EntityManager::reserve(std::size_t capacity)
+{
+    m_positions.reserve(capacity);
+    m_previousPositions.reserve(capacity);
+    m_velocities.reserve(capacity);
+    m_hitboxes.reserve(capacity);
+    m_types.reserve(capacity);
+    m_states.reserve(capacity);
+    m_health.reserve(capacity);
+    m_isActive.reserve(capacity);
+    m_denseToSlot.reserve(capacity);
+    m_slotToDense.reserve(capacity);
+    m_generations.reserve(capacity);
+    m_freeSlots.reserve(capacity);
+    m_activeIndices.reserve(capacity);
+}
+
+void EntityManager::clear()
+{
+    // Invalidate every outstanding handle but keep the slots (and the memory) for reuse
+    while (!m_positions.empty())
+        removeAt(static_cast<std::uint32_t>(m_positions.size() - 1));
+    m_score = 0;
+}
+
+EntityHandle EntityManager::spawnEntity(int entityUID, sf::Vector2f position)
+{
+    if (entityUID < 0 || entityUID >= static_cast<int>(ARCHETYPES.size()))
+        throw std::invalid_argument("EntityManager::spawnEntity: unknown entity UID " + std::to_string(entityUID));
+
+    const EntityArchetype& archetype = ARCHETYPES[static_cast<std::size_t>(entityUID)];
+
+    std::uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<std::uint32_t>(m_slotToDense.size());
+        m_slotToDense.push_back(INVALID_DENSE);
+        m_generations.push_back(0);
+    }
+
+    const std::uint32_t denseIndex = static_cast<std::uint32_t>(m_positions.size());
+    m_slotToDense[slot] = denseIndex;
+    m_denseToSlot.push_back(slot);
+
+    m_positions.push_back(position);
+    m_previousPositions.push_back(position);
+    m_velocities.push_back(archetype.velocity);
+    m_hitboxes.emplace_back(position, archetype.size);
+    m_types.push_back(archetype.type);
+    m_states.push_back(EntityState::Alive);
+    m_health.push_back(archetype.health);
+    m_isActive.push_back(isColliding(m_activeArea, m_hitboxes.back()));
+
+    return { slot, m_generations[slot] };
+}
+
+void EntityManager::spawnEntities(std::span<const LevelEntityRecord> records, sf::Vector2f offset, std::vector<EntityHandle>& handles)
+{
+    handles.reserve(handles.size() + records.size());
+    for (const LevelEntityRecord& record : records)
+        handles.push_back(spawnEntity(record.entityUID, { offset.x + record.x, offset.y + record.y }));
+}
+
+void EntityManager::destroyEntity(EntityHandle handle)
+{
+    const std::uint32_t denseIndex = getDenseIndex(handle);
+    if (denseIndex != INVALID_DENSE)
+        removeAt(denseIndex);
+}
+
+void EntityManager::destroyEntitiesLeftOf(float x)
+{
+    for (std::size_t i = m_hitboxes.size(); i-- > 0;)
+    {
+        if (m_hitboxes[i].position.x + m_hitboxes[i].size.x < x)
+            removeAt(static_cast<std::uint32_t>(i));
+    }
+}
+
+bool EntityManager::isAlive(EntityHandle handle) const
+{
+    const std::uint32_t denseIndex = getDenseIndex(handle);
+    return denseIndex != INVALID_DENSE && m_states[denseIndex] == EntityState::Alive;
+}
+
+void EntityManager::updateAll(float deltaTime)
+{
+    PROFILE_SCOPE(ProfileZone::Update);
+
+    // Raw pointers: the byte-sized active flags would otherwise force the compiler
+    // to reload the vectors' data pointers after every store
+    const std::size_t count = m_positions.size();
+    sf::Vector2f* positions = m_positions.data();
+    sf::Vector2f* previousPositions = m_previousPositions.data();
+    const sf::Vector2f* velocities = m_velocities.data();
+    sf::FloatRect* hitboxes = m_hitboxes.data();
+    std::uint8_t* isActive = m_isActive.data();
+    const sf::FloatRect activeArea = m_activeArea;
+
+    // Every entity only touches its own components: ranges can run in any order
+    const auto updateRange = [=](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            previousPositions[i] = positions[i];
+            positions[i] += velocities[i] * deltaTime;
+            hitboxes[i].position = positions[i];
+            isActive[i] = isColliding(activeArea, hitboxes[i]);
+        }
+    };
+
+    if (m_jobSystem)
+        m_jobSystem->parallelFor(count, UPDATE_BATCH_SIZE, updateRange);
+    else
+        updateRange(0, count);
+}
+
+void EntityManager::updateColisions()
+{
+    PROFILE_SCOPE(ProfileZone::Collision);
+
+    m_activeIndices.clear();
+    for (std::uint32_t i = 0; i < m_positions.size(); ++i)
+    {
+        if (m_isActive[i] && m_states[i] == EntityState::Alive)
+            m_activeIndices.push_back(i);
+    }
+
+    m_spatialGrid.findPairs(m_hitboxes, m_activeIndices, m_collisionPairs, m_jobSystem);
+
+    // Handles are taken before any removal, so onHit never sees a moved entity
+    for (const auto& [a, b] : m_collisionPairs)
+    {
+        const EntityHandle first = getHandle(a);
+        const EntityHandle second = getHandle(b);
+        onHit(first, second);
+        onHit(second, first);
+    }
+
+    removeDeadEntities();
+}
+
+void EntityManager::setActiveArea(const sf::FloatRect& area)
+{
+    m_activeArea = area;
+}
+
+void EntityManager::setLogicalResolution(sf::Vector2u logicalResolution)
+{
+    m_spatialGrid.setLogicalResolution(logicalResolution);
+}
+
+sf::Vector2f EntityManager::getPosition(EntityHandle handle) const
+{
+    return m_positions[checkedDenseIndex(handle)];
+}
+
+void EntityManager::setPosition(EntityHandle handle, sf::Vector2f position)
+{
+    const std::uint32_t denseIndex = checkedDenseIndex(handle);
+    m_positions[denseIndex] = position;
+    m_hitboxes[denseIndex].position = position;
+}
+
+sf::Vector2f EntityManager::getVelocity(EntityHandle handle) const
+{
+    return m_velocities[checkedDenseIndex(handle)];
+}
+
+void EntityManager::setVelocity(EntityHandle handle, sf::Vector2f velocity)
+{
+    m_velocities[checkedDenseIndex(handle)] = velocity;
+}
+
+sf::FloatRect EntityManager::getHitbox(EntityHandle handle) const
+{
+    return m_hitboxes[checkedDenseIndex(handle)];
+}
+
+EntityType EntityManager::getType(EntityHandle handle) const
+{
+    return m_types[checkedDenseIndex(handle)];
+}
+
+int EntityManager::getHealth(EntityHandle handle) const
+{
+    return m_health[checkedDenseIndex(handle)];
+}
+
+EntityHandle EntityManager::getHandle(std::size_t denseIndex) const
+{
+    const std::uint32_t slot = m_denseToSlot[denseIndex];
+    return { slot, m_generations[slot] };
+}
+
+void EntityManager::hashState(StateHash& hash) const
+{
+    hash.add(m_positions.size());
+    hash.add(std::span<const sf::Vector2f>(m_positions));
+    hash.add(std::span<const sf::Vector2f>(m_velocities));
+    hash.add(std::span<const EntityType>(m_types));
+    hash.add(std::span<const EntityState>(m_states));
+    hash.add(std::span<const int>(m_health));
+    hash.add(m_score);
+}
+
+std::uint32_t EntityManager::getDenseIndex(EntityHandle handle) const
+{
+    if (handle.index >= m_slotToDense.size() || m_generations[handle.index] != handle.generation)
+        return INVALID_DENSE;
+    return m_slotToDense[handle.index];
+}
+
+std::uint32_t EntityManager::checkedDenseIndex(EntityHandle handle) const
+{
+    const std::uint32_t denseIndex = getDenseIndex(handle);
+    if (denseIndex == INVALID_DENSE)
+        throw std::out_of_range("EntityManager: stale or invalid entity handle");
+    return denseIndex;
+}
+
+void EntityManager::removeAt(std::uint32_t denseIndex)
+{
+    const std::uint32_t lastIndex = static_cast<std::uint32_t>(m_positions.size() - 1);
+    const std::uint32_t removedSlot = m_denseToSlot[denseIndex];
+
+    // Swap-and-pop: the last entity takes the place of the removed one
+    if (denseIndex != lastIndex)
+    {
+        m_positions[denseIndex] = m_positions[lastIndex];
+        m_previousPositions[denseIndex] = m_previousPositions[lastIndex];
+        m_velocities[denseIndex] = m_velocities[lastIndex];
+        m_hitboxes[denseIndex] = m_hitboxes[lastIndex];
+        m_types[denseIndex] = m_types[lastIndex];
+        m_states[denseIndex] = m_states[lastIndex];
+        m_health[denseIndex] = m_health[lastIndex];
+        m_isActive[denseIndex] = m_isActive[lastIndex];
+
+        const std::uint32_t movedSlot = m_denseToSlot[lastIndex];
+        m_denseToSlot[denseIndex] = movedSlot;
+        m_slotToDense[movedSlot] = denseIndex;
+    }
+
+    m_positions.pop_back();
+    m_previousPositions.pop_back();
+    m_velocities.pop_back();
+    m_hitboxes.pop_back();
+    m_types.pop_back();
+    m_states.pop_back();
+    m_health.pop_back();
+    m_isActive.pop_back();
+    m_denseToSlot.pop_back();
+
+    m_slotToDense[removedSlot] = INVALID_DENSE;
+    ++m_generations[removedSlot];
+    m_freeSlots.push_back(removedSlot);
+}
+
+void EntityManager::removeDeadEntities()
+{
+    // Backwards so that the entity swapped in has already been visited
+    for (std::size_t i = m_positions.size(); i-- > 0;)
+    {
+        if (m_states[i] == EntityState::Dead)
+            removeAt(static_cast<std::uint32_t>(i));
+    }
+}
+
+void EntityManager::onHit(EntityHandle entity, EntityHandle otherEntity)
+{
+    const std::uint32_t self = getDenseIndex(entity);
+    const std::uint32_t other = getDenseIndex(otherEntity);
+    if (self == INVALID_DENSE || other == INVALID_DENSE)
+        return;
+
+    switch (m_types[self])
+    {
+    case EntityType::Player:
+        switch (m_types[other])
+        {
+        case EntityType::Spike:
+        case EntityType::MovingEnemy:
+            m_health[self] = 0;
+            break;
+        case EntityType::Projectile:
+            --m_health[self];
+            break;
+        case EntityType::Collectible:
+            ++m_score;
+            break;
+        default:
+            break;
+        }
+        if (m_health[self] <= 0)
+            m_states[self] = EntityState::Dead;
+        break;
+
+    case EntityType::Projectile:
+    case EntityType::Collectible:
+        if (m_types[other] == EntityType::Player)
+            m_states[self] = EntityState::Dead;
+        break;
+
+    default:
+        break;
+    }
+}
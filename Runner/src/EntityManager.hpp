@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "Entity.hpp"
+#include "LevelData.hpp"
+#include "SpatialGrid.hpp"
+
+class JobSystem;
+class StateHash;
+
+// Owns every entity of the level in a structure-of-arrays layout.
+// Each component lives in its own contiguous array and index i of every array
+// belongs to the same entity, so updateAll() walks memory linearly and never
+// goes through a pointer or a virtual call.
+// Entities are referred to from the outside through generational handles.
+// Removal is swap-and-pop, which keeps the arrays dense.
+class EntityManager
+{
+public:
+    EntityManager();
+
+    void reserve(std::size_t capacity);
+    void clear();
+
+    // updateAll() and the broad phase of updateColisions() split their work over jobSystem,
+    // with the same results as on one thread. nullptr (the default): the calling thread only.
+    void setJobSystem(JobSystem* jobSystem) { m_jobSystem = jobSystem; }
+
+    // entityUID indexes the archetype table (see EntityManager.cpp)
+    EntityHandle spawnEntity(int entityUID, sf::Vector2f position);
+    // Spawns a whole level chunk at once, positions are offset by offset. Handles are appended to handles.
+    void spawnEntities(std::span<const LevelEntityRecord> records, sf::Vector2f offset, std::vector<EntityHandle>& handles);
+    void destroyEntity(EntityHandle handle);
+    // Removes everything that is entirely on the left of x (behind the camera)
+    void destroyEntitiesLeftOf(float x);
+    bool isAlive(EntityHandle handle) const;
+
+    // Saves the current positions as the previous ones, then moves every entity
+    void updateAll(float deltaTime);
+    void updateColisions();
+
+    // Only entities whose hitbox touches this area are active (checked for collisions)
+    void setActiveArea(const sf::FloatRect& area);
+    // Sizes the broad phase cells
+    void setLogicalResolution(sf::Vector2u logicalResolution);
+
+    // Getters / setters through handles
+    sf::Vector2f getPosition(EntityHandle handle) const;
+    // Moves within the current tick: the previous position is kept for interpolation
+    void setPosition(EntityHandle handle, sf::Vector2f position);
+    sf::Vector2f getVelocity(EntityHandle handle) const;
+    void setVelocity(EntityHandle handle, sf::Vector2f velocity);
+    sf::FloatRect getHitbox(EntityHandle handle) const;
+    EntityType getType(EntityHandle handle) const;
+    int getHealth(EntityHandle handle) const;
+
+    std::size_t getEntityCount() const { return m_positions.size(); }
+    int getScore() const { return m_score; }
+
+    // Raw component arrays, indexed by dense index (valid until the next spawn/destroy)
+    const std::vector<sf::Vector2f>& getPositions() const { return m_positions; }
+    // Positions at the start of the last updateAll(), rendering interpolates between both
+    const std::vector<sf::Vector2f>& getPreviousPositions() const { return m_previousPositions; }
+    const std::vector<sf::FloatRect>& getHitboxes() const { return m_hitboxes; }
+    const std::vector<EntityType>& getTypes() const { return m_types; }
+    const std::vector<std::uint8_t>& getActiveFlags() const { return m_isActive; }
+    EntityHandle getHandle(std::size_t denseIndex) const;
+
+    // Adds every component and the score to hash (replays compare final states this way)
+    void hashState(StateHash& hash) const;
+
+private:
+    static constexpr std::uint32_t INVALID_DENSE = 0xFFFFFFFFu;
+
+    std::uint32_t getDenseIndex(EntityHandle handle) const;
+    std::uint32_t checkedDenseIndex(EntityHandle handle) const;
+    void removeAt(std::uint32_t denseIndex);
+    void removeDeadEntities();
+    void onHit(EntityHandle entity, EntityHandle otherEntity);
+
+    // Components (dense, one entry per living entity)
+    std::vector<sf::Vector2f> m_positions;
+    std::vector<sf::Vector2f> m_previousPositions;
+    std::vector<sf::Vector2f> m_velocities;
+    std::vector<sf::FloatRect> m_hitboxes;
+    std::vector<EntityType> m_types;
+    std::vector<EntityState> m_states;
+    std::vector<int> m_health;
+    std::vector<std::uint8_t> m_isActive;
+
+    // Handle bookkeeping
+    std::vector<std::uint32_t> m_denseToSlot;
+    std::vector<std::uint32_t> m_slotToDense;
+    std::vector<std::uint32_t> m_generations;
+    std::vector<std::uint32_t> m_freeSlots;
+
+    // Scratch buffers reused every tick
+    std::vector<std::uint32_t> m_activeIndices;
+    std::vector<SpatialGrid::Pair> m_collisionPairs;
+    SpatialGrid m_spatialGrid;
+
+    JobSystem* m_jobSystem = nullptr;
+
+    sf::FloatRect m_activeArea;
+    int m_score = 0;
+};
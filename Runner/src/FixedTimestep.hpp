@@ -0,0 +1,44 @@
+#pragma once
+
+#include <algorithm>
+
+// Accumulator turning variable frame times into a whole number of fixed simulation ticks.
+// When rendering falls too far behind, at most m_maxCatchUpSteps ticks are run per frame
+// and the remaining backlog is dropped, instead of spiralling into ever longer frames.
+class FixedTimestep
+{
+public:
+    FixedTimestep(float tickDuration, int maxCatchUpSteps)
+        : m_tickDuration(tickDuration), m_maxCatchUpSteps(maxCatchUpSteps)
+    {
+    }
+
+    // Returns how many ticks to simulate for a frame that lasted frameTime seconds
+    int advance(float frameTime)
+    {
+        m_accumulator += std::max(frameTime, 0.f);
+
+        int steps = 0;
+        while (m_accumulator >= m_tickDuration && steps < m_maxCatchUpSteps)
+        {
+            m_accumulator -= m_tickDuration;
+            ++steps;
+        }
+
+        if (steps == m_maxCatchUpSteps)
+            m_accumulator = std::min(m_accumulator, m_tickDuration);
+        return steps;
+    }
+
+    // How far (0..1) the rendered frame is between the last two simulated states
+    float getAlpha() const { return std::min(m_accumulator / m_tickDuration, 1.f); }
+
+    float getTickDuration() const { return m_tickDuration; }
+
+    void reset() { m_accumulator = 0.f; }
+
+private:
+    float m_tickDuration;
+    int m_maxCatchUpSteps;
+    float m_accumulator = 0.f;
+};
@@ -0,0 +1,348 @@
+#include "Game.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/VideoMode.hpp>
+
+#include "Replay.hpp"
+
+namespace
+{
+    constexpr std::uint32_t DEFAULT_SEED = 0x5EED;
+
+    constexpr const char* TEXTURE_DIRECTORY = "assets/textures";
+
+#ifdef RUNNER_PROFILING
+    // Profiler overlay, top left of the UI view: one row per zone, one bar per frame,
+    // a full row is a whole frame budget
+    constexpr float PROFILER_BAR_WIDTH = 2.f;
+    constexpr float PROFILER_ROW_HEIGHT = 48.f;
+    constexpr float PROFILER_ROW_SPACING = 6.f;
+    constexpr float PROFILER_MARGIN = 16.f;
+    constexpr float PROFILER_FRAME_BUDGET_MS = 1000.f / 60.f;
+    const sf::Color PROFILER_BACKGROUND_COLOR = { 0, 0, 0, 160 };
+    const sf::Color PROFILER_ZONE_COLORS[PROFILE_ZONE_COUNT] = {
+        { 80, 200, 120 },  // Update
+        { 240, 200, 60 },  // Collision
+        { 80, 150, 255 },  // Draw
+        { 220, 110, 230 }, // UI
+        { 255, 140, 60 }   // LevelStreaming
+    };
+
+    // The trace is flushed every second of headless ticks, well before the ring buffers wrap
+    constexpr std::uint64_t TRACE_FLUSH_TICKS = Simulation::TICK_RATE;
+
+    // Two triangles
+    void appendQuad(std::vector<sf::Vertex>& vertices, sf::Vector2f topLeft, sf::Vector2f size, sf::Color color)
+    {
+        const sf::Vector2f bottomRight = topLeft + size;
+        vertices.push_back({ topLeft, color });
+        vertices.push_back({ { bottomRight.x, topLeft.y }, color });
+        vertices.push_back({ { topLeft.x, bottomRight.y }, color });
+        vertices.push_back({ { topLeft.x, bottomRight.y }, color });
+        vertices.push_back({ { bottomRight.x, topLeft.y }, color });
+        vertices.push_back({ bottomRight, color });
+    }
+#endif
+
+    sf::Vector2f lerp(sf::Vector2f from, sf::Vector2f to, float alpha)
+    {
+        return from + (to - from) * alpha;
+    }
+}
+
+Game::Game()
+    : m_stageView(static_cast<sf::Vector2f>(m_logicalResolution) / 2.f, static_cast<sf::Vector2f>(m_logicalResolution)),
+      m_uiView(m_stageView),
+      m_simulation(std::make_unique<Simulation>(m_logicalResolution, DEFAULT_SEED)),
+      m_timestep(Simulation::TICK_DURATION, m_MAX_CATCH_UP_STEPS)
+{
+    m_simulation->setJobSystem(&m_jobSystem);
+}
+
+void Game::loadLevel(int levelUID, bool isInfinite)
+{
+    m_simulation->loadLevel(levelUID, isInfinite);
+}
+
+void Game::run()
+{
+    m_window = std::make_unique<sf::RenderWindow>(sf::VideoMode({ 1280, 720 }), "Runner");
+    m_window->setFramerateLimit(m_FRAME_RATE);
+    centerWindow();
+
+    m_textureAtlas.loadFromDirectory(TEXTURE_DIRECTORY);
+    m_renderBatcher.setTextureRects(m_textureAtlas.getTextureRects());
+
+    sf::Clock deltaClock;
+    m_timestep.reset();
+
+    while (m_window->isOpen())
+    {
+        pollEvents();
+
+        const float deltaTime = deltaClock.restart().asSeconds();
+        const int steps = m_timestep.advance(deltaTime);
+        for (int step = 0; step < steps; ++step)
+        {
+            m_simulation->advance(m_input);
+            if (!m_recordingPath.empty())
+                m_recording.inputs.push_back(m_input);
+        }
+
+        render(m_timestep.getAlpha());
+        endProfilerFrame();
+    }
+
+    saveRecording();
+    terminate();
+}
+
+double Game::runHeadless(std::uint64_t tickCount)
+{
+    using Clock = std::chrono::steady_clock;
+
+    std::uint64_t runCount = 1;
+    const Clock::time_point start = Clock::now();
+    for (std::uint64_t tick = 0; tick < tickCount; ++tick)
+    {
+        if (m_simulation->advance(m_input))
+            ++runCount;
+#ifdef RUNNER_PROFILING
+        if (tick % TRACE_FLUSH_TICKS == 0)
+            m_traceWriter.flush();
+#endif
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    const double ticksPerSecond = seconds > 0.0 ? static_cast<double>(tickCount) / seconds : 0.0;
+
+    std::cout << "Headless: " << tickCount << " ticks (" << runCount << " runs) in " << seconds << " s, "
+              << ticksPerSecond << " ticks/s" << std::endl;
+
+    terminate();
+    return ticksPerSecond;
+}
+
+void Game::recordTo(const std::filesystem::path& filePath)
+{
+    const LevelManager& levelManager = m_simulation->getLevelManager();
+
+    m_recordingPath = filePath;
+    m_recording = {};
+    m_recording.seed = m_simulation->getSeed();
+    m_recording.levelUID = levelManager.isLoaded() ? levelManager.getCurrentLevelUID() : -1;
+    m_recording.isInfinite = levelManager.isInfinite();
+    m_recording.inputs.reserve(static_cast<std::size_t>(Simulation::TICK_RATE) * 60 * 10);
+}
+
+void Game::saveRecording()
+{
+    if (m_recordingPath.empty())
+        return;
+
+    m_recording.finalStateHash = m_simulation->computeStateHash();
+    try
+    {
+        saveInputRecording(m_recording, m_recordingPath);
+        std::cout << "Recorded " << m_recording.inputs.size() << " ticks to " << m_recordingPath.string() << std::endl;
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+    }
+}
+
+bool Game::runReplay(const std::filesystem::path& filePath)
+{
+    const InputRecording recording = loadInputRecording(filePath);
+    const ReplayResult result = replayRecording(recording, m_logicalResolution, false, &m_jobSystem);
+    const bool isMatching = result.matches(recording);
+
+    std::cout << "Replay: " << result.tickCount << " ticks (" << result.runCount << " runs) in " << result.seconds << " s, "
+              << result.getTicksPerSecond() << " ticks/s, final state " << std::hex << result.finalStateHash << std::dec
+              << (isMatching ? "" : " (does not match the recording)") << std::endl;
+
+    terminate();
+    return isMatching;
+}
+
+void Game::traceTo(const std::filesystem::path& filePath)
+{
+#ifdef RUNNER_PROFILING
+    m_traceWriter.open(filePath);
+    PROFILE_THREAD_NAME("Main");
+#else
+    throw std::runtime_error("Cannot trace to " + filePath.string() + ", built without RUNNER_PROFILING");
+#endif
+}
+
+void Game::terminate()
+{
+#ifdef RUNNER_PROFILING
+    m_traceWriter.close();
+#endif
+    if (m_window && m_window->isOpen())
+        m_window->close();
+}
+
+void Game::pollEvents()
+{
+    while (const std::optional event = m_window->pollEvent())
+    {
+        if (event->is<sf::Event::Closed>())
+        {
+            m_window->close();
+        }
+        else if (event->is<sf::Event::FocusLost>())
+        {
+            m_input = {};
+        }
+        else if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>())
+        {
+            switch (keyPressed->code)
+            {
+            case sf::Keyboard::Key::Up:    case sf::Keyboard::Key::Z: m_input.setPressed(InputAction::Up, true); break;
+            case sf::Keyboard::Key::Down:  case sf::Keyboard::Key::S: m_input.setPressed(InputAction::Down, true); break;
+            case sf::Keyboard::Key::Left:  case sf::Keyboard::Key::Q: m_input.setPressed(InputAction::Left, true); break;
+            case sf::Keyboard::Key::Right: case sf::Keyboard::Key::D: m_input.setPressed(InputAction::Right, true); break;
+#ifdef RUNNER_PROFILING
+            case sf::Keyboard::Key::F3: m_isProfilerOverlayVisible = !m_isProfilerOverlayVisible; break;
+#endif
+            default: break;
+            }
+        }
+        else if (const auto* keyReleased = event->getIf<sf::Event::KeyReleased>())
+        {
+            switch (keyReleased->code)
+            {
+            case sf::Keyboard::Key::Up:    case sf::Keyboard::Key::Z: m_input.setPressed(InputAction::Up, false); break;
+            case sf::Keyboard::Key::Down:  case sf::Keyboard::Key::S: m_input.setPressed(InputAction::Down, false); break;
+            case sf::Keyboard::Key::Left:  case sf::Keyboard::Key::Q: m_input.setPressed(InputAction::Left, false); break;
+            case sf::Keyboard::Key::Right: case sf::Keyboard::Key::D: m_input.setPressed(InputAction::Right, false); break;
+            default: break;
+            }
+        }
+    }
+}
+
+void Game::centerWindow()
+{
+    const sf::Vector2u desktopSize = sf::VideoMode::getDesktopMode().size;
+    const sf::Vector2u windowSize = m_window->getSize();
+    m_window->setPosition({ static_cast<int>(desktopSize.x - windowSize.x) / 2, static_cast<int>(desktopSize.y - windowSize.y) / 2 });
+}
+
+void Game::render(float alpha)
+{
+    m_stageView.setCenter(lerp(m_simulation->getPreviousCameraCenter(), m_simulation->getCameraCenter(), alpha));
+
+    // Pure CPU work on the entities, which do not change until the next tick
+    const sf::FloatRect viewRect(m_stageView.getCenter() - m_stageView.getSize() / 2.f, m_stageView.getSize());
+    const auto buildBatches = [this, &viewRect, alpha]
+    {
+        PROFILE_SCOPE(ProfileZone::Draw);
+        m_renderBatcher.build(m_simulation->getEntityManager(), viewRect, alpha);
+    };
+    JobCounter batchJob;
+    m_jobSystem.run(batchJob, buildBatches);
+
+    // Presents the frame drawn by the previous render() meanwhile; it also waits for the frame rate limit
+    m_window->display();
+    m_jobSystem.wait(batchJob);
+
+    {
+        PROFILE_SCOPE(ProfileZone::Draw);
+        m_window->clear();
+        m_window->setView(m_stageView);
+
+        sf::RenderStates states;
+        states.texture = &m_textureAtlas.getTexture();
+        for (const RenderBatch& batch : m_renderBatcher.getBatches())
+        {
+            if (batch.vertices.empty())
+                continue;
+            states.blendMode = batch.blend == BlendLayer::Additive ? sf::BlendAdd : sf::BlendAlpha;
+            m_window->draw(batch.vertices.data(), batch.vertices.size(), sf::PrimitiveType::Triangles, states);
+        }
+    }
+
+    {
+        PROFILE_SCOPE(ProfileZone::UI);
+        m_window->setView(m_uiView);
+        drawProfilerOverlay();
+    }
+
+    reportRenderStats();
+}
+
+void Game::drawProfilerOverlay()
+{
+#ifdef RUNNER_PROFILING
+    if (!m_isProfilerOverlayVisible)
+        return;
+
+    m_profilerVertices.clear();
+    const sf::Vector2f rowSize = { PROFILER_BAR_WIDTH * ProfileHistory::HISTORY_SIZE, PROFILER_ROW_HEIGHT };
+    for (std::size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+        appendQuad(m_profilerVertices, { PROFILER_MARGIN, PROFILER_MARGIN + zone * (PROFILER_ROW_HEIGHT + PROFILER_ROW_SPACING) }, rowSize, PROFILER_BACKGROUND_COLOR);
+
+    for (std::size_t age = 0; age < ProfileHistory::HISTORY_SIZE; ++age)
+    {
+        const ProfileHistory::Frame frame = m_profileHistory.getFrame(age);
+        const float x = PROFILER_MARGIN + age * PROFILER_BAR_WIDTH;
+        for (std::size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+        {
+            // Clamped to the row: a bar reaching the top means the zone alone took the whole frame
+            const float height = std::min(frame[zone] / PROFILER_FRAME_BUDGET_MS, 1.f) * PROFILER_ROW_HEIGHT;
+            if (height <= 0.f)
+                continue;
+            const float rowBottom = PROFILER_MARGIN + zone * (PROFILER_ROW_HEIGHT + PROFILER_ROW_SPACING) + PROFILER_ROW_HEIGHT;
+            appendQuad(m_profilerVertices, { x, rowBottom - height }, { PROFILER_BAR_WIDTH, height }, PROFILER_ZONE_COLORS[zone]);
+        }
+    }
+
+    m_window->draw(m_profilerVertices.data(), m_profilerVertices.size(), sf::PrimitiveType::Triangles);
+#endif
+}
+
+void Game::endProfilerFrame()
+{
+#ifdef RUNNER_PROFILING
+    m_profileHistory.endFrame();
+    m_traceWriter.flush();
+#endif
+}
+
+void Game::reportRenderStats()
+{
+    if (m_renderStatsClock.getElapsedTime() < sf::seconds(1.f))
+        return;
+    m_renderStatsClock.restart();
+
+    const RenderStats& stats = m_renderBatcher.getStats();
+    std::string title = "Runner - " + std::to_string(stats.drawCalls) + " draw calls, "
+        + std::to_string(stats.vertexCount) + " vertices, " + std::to_string(stats.culledEntities) + " culled";
+
+#ifdef RUNNER_PROFILING
+    // No font for the overlay: the zone averages go in the title, in the overlay's row order
+    if (m_isProfilerOverlayVisible)
+    {
+        std::ostringstream averages;
+        averages << std::fixed << std::setprecision(2);
+        for (std::size_t zone = 0; zone < PROFILE_ZONE_COUNT; ++zone)
+            averages << " | " << getProfileZoneName(static_cast<ProfileZone>(zone)) << ' ' << m_profileHistory.getAverage(static_cast<ProfileZone>(zone)) << " ms";
+        title += averages.str();
+    }
+#endif
+
+    m_window->setTitle(title);
+}
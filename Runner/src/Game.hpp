@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Clock.hpp>
+
+#include "FixedTimestep.hpp"
+#include "InputRecording.hpp"
+#include "InputState.hpp"
+#include "JobSystem.hpp"
+#include "Profiler.hpp"
+#include "RenderBatcher.hpp"
+#include "Simulation.hpp"
+#include "TextureAtlas.hpp"
+
+// Owns the window and the game loop.
+// The simulation always advances by fixed ticks (Simulation::TICK_DURATION);
+// rendering happens once per frame and interpolates between the last two ticks.
+// The entity update and the broad phase run on every core through m_jobSystem, and the
+// render batches of a frame are built on a worker while the previous one is displayed.
+class Game
+{
+public:
+    Game();
+
+    // Throws if the level file cannot be opened
+    void loadLevel(int levelUID, bool isInfinite);
+
+    // Windowed game loop, returns when the window is closed
+    void run();
+    // No window: simulates tickCount ticks as fast as possible and returns the ticks per second
+    double runHeadless(std::uint64_t tickCount);
+    // Records the inputs of every tick of run() into filePath, saved when run() returns.
+    // Call after loadLevel(): the recording starts from the current state.
+    void recordTo(const std::filesystem::path& filePath);
+    // No window: replays a recording and returns false if it did not end in the recorded state
+    bool runReplay(const std::filesystem::path& filePath);
+    // Writes the profiler events of run() or runHeadless() to a Chrome trace JSON file.
+    // Throws if the file cannot be created or the build has no RUNNER_PROFILING.
+    void traceTo(const std::filesystem::path& filePath);
+    void terminate();
+
+private:
+    void pollEvents();
+    void centerWindow();
+    void render(float alpha);
+    void drawProfilerOverlay();
+    void endProfilerFrame();
+    void reportRenderStats();
+    void saveRecording();
+
+    const int m_FRAME_RATE = 60;
+    const int m_MAX_CATCH_UP_STEPS = 5;
+    const sf::Vector2u m_logicalResolution = { 1920, 1080 };
+
+    std::unique_ptr<sf::RenderWindow> m_window;
+    sf::View m_stageView;
+    sf::View m_uiView;
+
+    JobSystem m_jobSystem; // before m_simulation, which refers to it
+    std::unique_ptr<Simulation> m_simulation;
+    FixedTimestep m_timestep;
+    InputState m_input;
+
+    std::filesystem::path m_recordingPath; // empty: not recording
+    InputRecording m_recording;
+
+    TextureAtlas m_textureAtlas;
+    RenderBatcher m_renderBatcher;
+    sf::Clock m_renderStatsClock;
+
+#ifdef RUNNER_PROFILING
+    ProfileHistory m_profileHistory;
+    ChromeTraceWriter m_traceWriter;
+    bool m_isProfilerOverlayVisible = false; // toggled with F3
+    std::vector<sf::Vertex> m_profilerVertices;
+#endif
+};
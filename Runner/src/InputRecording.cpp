@@ -0,0 +1,116 @@
+#include "InputRecording.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+    constexpr char RECORDING_MAGIC[4] = { 'R', 'R', 'E', 'C' };
+    constexpr std::uint32_t RECORDING_VERSION = 1;
+
+    static_assert(std::endian::native == std::endian::little, "Recordings are written in the file's byte order");
+
+    template <typename T>
+    void writeValue(std::ofstream& file, const T& value)
+    {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(std::ifstream& file, const std::filesystem::path& filePath)
+    {
+        T value{};
+        if (!file.read(reinterpret_cast<char*>(&value), sizeof(T)))
+            throw std::runtime_error("loadInputRecording: " + filePath.string() + " is truncated");
+        return value;
+    }
+
+    void writeVarint(std::ofstream& file, std::uint64_t value)
+    {
+        while (value >= 0x80)
+        {
+            file.put(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        file.put(static_cast<char>(value));
+    }
+
+    std::uint64_t readVarint(std::ifstream& file, const std::filesystem::path& filePath)
+    {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            const std::uint8_t byte = readValue<std::uint8_t>(file, filePath);
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        throw std::runtime_error("loadInputRecording: " + filePath.string() + " has a bad run length");
+    }
+}
+
+void saveInputRecording(const InputRecording& recording, const std::filesystem::path& filePath)
+{
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file)
+        throw std::runtime_error("saveInputRecording: cannot create " + filePath.string());
+
+    file.write(RECORDING_MAGIC, sizeof(RECORDING_MAGIC));
+    writeValue(file, RECORDING_VERSION);
+    writeValue(file, recording.seed);
+    writeValue(file, static_cast<std::int32_t>(recording.levelUID));
+    writeValue(file, static_cast<std::uint8_t>(recording.isInfinite));
+    writeValue(file, static_cast<std::uint64_t>(recording.inputs.size()));
+    writeValue(file, recording.finalStateHash);
+
+    for (std::size_t i = 0; i < recording.inputs.size();)
+    {
+        const InputState input = recording.inputs[i];
+        std::size_t runEnd = i + 1;
+        while (runEnd < recording.inputs.size() && recording.inputs[runEnd] == input)
+            ++runEnd;
+
+        writeValue(file, input.actions);
+        writeVarint(file, runEnd - i);
+        i = runEnd;
+    }
+
+    if (!file.flush())
+        throw std::runtime_error("saveInputRecording: cannot write " + filePath.string());
+}
+
+InputRecording loadInputRecording(const std::filesystem::path& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("loadInputRecording: cannot open " + filePath.string());
+
+    char magic[sizeof(RECORDING_MAGIC)] = {};
+    file.read(magic, sizeof(magic));
+    if (!file || !std::equal(std::begin(magic), std::end(magic), RECORDING_MAGIC))
+        throw std::runtime_error("loadInputRecording: " + filePath.string() + " is not an input recording");
+
+    const std::uint32_t version = readValue<std::uint32_t>(file, filePath);
+    if (version != RECORDING_VERSION)
+        throw std::runtime_error("loadInputRecording: " + filePath.string() + " has version " + std::to_string(version));
+
+    InputRecording recording;
+    recording.seed = readValue<std::uint32_t>(file, filePath);
+    recording.levelUID = readValue<std::int32_t>(file, filePath);
+    recording.isInfinite = readValue<std::uint8_t>(file, filePath) != 0;
+    const std::uint64_t tickCount = readValue<std::uint64_t>(file, filePath);
+    recording.finalStateHash = readValue<std::uint64_t>(file, filePath);
+
+    while (recording.inputs.size() < tickCount)
+    {
+        const InputState input{ readValue<std::uint8_t>(file, filePath) };
+        const std::uint64_t runLength = readVarint(file, filePath);
+        if (runLength == 0 || runLength > tickCount - recording.inputs.size())
+            throw std::runtime_error("loadInputRecording: " + filePath.string() + " has a bad run length");
+        recording.inputs.insert(recording.inputs.end(), static_cast<std::size_t>(runLength), input);
+    }
+    return recording;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include "InputState.hpp"
+
+// Everything needed to replay a run. The simulation is deterministic, so the seed,
+// the level and the input of every fixed tick are enough to rebuild the whole run.
+struct InputRecording
+{
+    std::uint32_t seed = 0;
+    int levelUID = -1; // -1: no level loaded
+    bool isInfinite = false;
+    std::vector<InputState> inputs; // one per tick
+    // Simulation::computeStateHash() after the last tick, 0 if unknown
+    std::uint64_t finalStateHash = 0;
+
+    bool operator==(const InputRecording&) const = default;
+};
+
+// Input recording file (.rrec), little-endian:
+//
+//     "RREC", version, seed, levelUID, isInfinite, tickCount, finalStateHash
+//     (actions, run length) pairs: actions is the InputState byte, repeated run length
+//     ticks (LEB128 varint). Inputs change rarely, a minute of play fits in a few hundred bytes.
+//
+// Both throw std::runtime_error on failure.
+void saveInputRecording(const InputRecording& recording, const std::filesystem::path& filePath);
+InputRecording loadInputRecording(const std::filesystem::path& filePath);
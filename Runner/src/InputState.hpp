@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+
+// What the player is asking for during one simulation tick.
+// Filled by Game::pollEvents() and read by Player::handleInputs(), so the
+// simulation never touches SFML events directly.
+enum class InputAction : std::uint8_t
+{
+    Up = 1 << 0,
+    Down = 1 << 1,
+    Left = 1 << 2,
+    Right = 1 << 3
+};
+
+struct InputState
+{
+    std::uint8_t actions = 0;
+
+    bool isPressed(InputAction action) const { return (actions & static_cast<std::uint8_t>(action)) != 0; }
+
+    void setPressed(InputAction action, bool isPressed)
+    {
+        if (isPressed)
+            actions |= static_cast<std::uint8_t>(action);
+        else
+            actions &= static_cast<std::uint8_t>(~static_cast<std::uint8_t>(action));
+    }
+
+    bool operator==(const InputState&) const = default;
+};
@@ -0,0 +1,141 @@
+#include "JobSystem.hpp"
+
+#include "Profiler.hpp"
+
+namespace
+{
+    // Set on worker threads only: the JobSystem they belong to and their queue
+    thread_local const JobSystem* t_jobSystem = nullptr;
+    thread_local std::size_t t_queueIndex = 0;
+}
+
+JobSystem::JobSystem(unsigned int threadCount)
+{
+    if (threadCount == 0)
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    m_queues.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; ++i)
+        m_queues.push_back(std::make_unique<JobQueue>());
+
+    m_workers.reserve(threadCount - 1);
+    for (std::size_t queueIndex = 1; queueIndex < threadCount; ++queueIndex)
+        m_workers.emplace_back(&JobSystem::workerLoop, this, queueIndex);
+}
+
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard lock(m_wakeMutex);
+        m_isStopping = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (std::thread& worker : m_workers)
+        worker.join();
+}
+
+void JobSystem::wait(JobCounter& counter)
+{
+    const std::size_t queueIndex = getQueueIndex();
+    while (!counter.isDone())
+    {
+        // The remaining jobs are running on other threads
+        if (!tryRunJob(queueIndex))
+            std::this_thread::yield();
+    }
+}
+
+bool JobSystem::JobQueue::push(const Job& job)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_size == CAPACITY)
+        return false;
+
+    m_jobs[(m_first + m_size) % CAPACITY] = job;
+    ++m_size;
+    return true;
+}
+
+bool JobSystem::JobQueue::pop(Job& job)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_size == 0)
+        return false;
+
+    --m_size;
+    job = m_jobs[(m_first + m_size) % CAPACITY];
+    return true;
+}
+
+bool JobSystem::JobQueue::steal(Job& job)
+{
+    std::lock_guard lock(m_mutex);
+    if (m_size == 0)
+        return false;
+
+    job = m_jobs[m_first];
+    m_first = (m_first + 1) % CAPACITY;
+    --m_size;
+    return true;
+}
+
+void JobSystem::push(JobCounter& counter, const Job& job)
+{
+    counter.m_pendingJobCount.fetch_add(1, std::memory_order_relaxed);
+    if (!m_queues[getQueueIndex()]->push(job))
+    {
+        execute(job);
+        return;
+    }
+
+    m_queuedJobCount.fetch_add(1, std::memory_order_release);
+    {
+        // Taking the lock orders this push with a worker checking m_queuedJobCount before sleeping
+        std::lock_guard lock(m_wakeMutex);
+    }
+    m_wakeCondition.notify_one();
+}
+
+bool JobSystem::tryRunJob(std::size_t queueIndex)
+{
+    Job job;
+    bool isFound = m_queues[queueIndex]->pop(job);
+    for (std::size_t offset = 1; !isFound && offset < m_queues.size(); ++offset)
+        isFound = m_queues[(queueIndex + offset) % m_queues.size()]->steal(job);
+    if (!isFound)
+        return false;
+
+    m_queuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(const Job& job)
+{
+    job.function(job.context, job.begin, job.end);
+    job.counter->m_pendingJobCount.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::workerLoop(std::size_t queueIndex)
+{
+    t_jobSystem = this;
+    t_queueIndex = queueIndex;
+    PROFILE_THREAD_NAME("Job worker");
+
+    for (;;)
+    {
+        if (tryRunJob(queueIndex))
+            continue;
+
+        std::unique_lock lock(m_wakeMutex);
+        m_wakeCondition.wait(lock, [this] { return m_isStopping || m_queuedJobCount.load(std::memory_order_acquire) > 0; });
+        if (m_isStopping)
+            return;
+    }
+}
+
+std::size_t JobSystem::getQueueIndex() const
+{
+    return t_jobSystem == this ? t_queueIndex : 0;
+}
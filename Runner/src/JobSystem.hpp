@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Jobs of one group that have not finished yet: JobSystem::wait() returns once it drops to zero.
+class JobCounter
+{
+public:
+    bool isDone() const { return m_pendingJobCount.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+
+    std::atomic<std::size_t> m_pendingJobCount{ 0 };
+};
+
+// Small work-stealing scheduler.
+// Every thread has its own job queue: it pushes and pops its own jobs at the back (the
+// most recent, still in cache) and, once empty, steals from the front of the others.
+// The thread that owns the JobSystem (the main thread) has a queue too and runs jobs
+// while it waits, so a JobSystem of one thread runs everything on the caller.
+// A job is a function pointer and a context pointer: submitting never allocates.
+// Jobs must not throw.
+//
+//     m_jobSystem.parallelFor(count, BATCH_SIZE, [=](std::size_t begin, std::size_t end)
+//     {
+//         for (std::size_t i = begin; i < end; ++i)
+//             positions[i] += velocities[i] * deltaTime;
+//     });
+class JobSystem
+{
+public:
+    // threadCount includes the owner thread, threadCount - 1 workers are started.
+    // 0: one thread per hardware thread.
+    explicit JobSystem(unsigned int threadCount = 0);
+    // Jobs still queued are not run: wait() for them first
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    unsigned int getThreadCount() const { return static_cast<unsigned int>(m_workers.size()) + 1; }
+
+    // Queues function() to run on any thread. function must stay alive until wait(counter) returns.
+    template <typename Function>
+    void run(JobCounter& counter, const Function& function)
+    {
+        push(counter, { &invoke<Function>, &function, 0, 0, &counter });
+    }
+    template <typename Function>
+    void run(JobCounter& counter, const Function&& function) = delete;
+
+    // Calls function(begin, end) on ranges of at most batchSize covering [0, count), and
+    // returns once they all ran. Ranges run concurrently: function may only write to
+    // data of its own range. With one thread, function(0, count) runs on the caller.
+    template <typename Function>
+    void parallelFor(std::size_t count, std::size_t batchSize, const Function& function)
+    {
+        if (count == 0)
+            return;
+        if (m_workers.empty() || count <= batchSize)
+        {
+            function(std::size_t(0), count);
+            return;
+        }
+
+        JobCounter counter;
+        for (std::size_t begin = 0; begin < count; begin += batchSize)
+            push(counter, { &invokeRange<Function>, &function, begin, std::min(begin + batchSize, count), &counter });
+        wait(counter);
+    }
+
+    // Runs queued jobs (this thread's first, then stolen ones) until counter's jobs are done
+    void wait(JobCounter& counter);
+
+private:
+    struct Job
+    {
+        void (*function)(const void* context, std::size_t begin, std::size_t end);
+        const void* context;
+        std::size_t begin;
+        std::size_t end;
+        JobCounter* counter;
+    };
+
+    // Bounded ring: when it is full, push() fails and the job runs inline instead of growing the queue
+    class JobQueue
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 1024;
+
+        bool push(const Job& job);
+        // Owner side, newest job
+        bool pop(Job& job);
+        // Thief side, oldest job
+        bool steal(Job& job);
+
+    private:
+        std::mutex m_mutex;
+        std::array<Job, CAPACITY> m_jobs;
+        std::size_t m_first = 0;
+        std::size_t m_size = 0;
+    };
+
+    template <typename Function>
+    static void invoke(const void* context, std::size_t, std::size_t)
+    {
+        (*static_cast<const Function*>(context))();
+    }
+
+    template <typename Function>
+    static void invokeRange(const void* context, std::size_t begin, std::size_t end)
+    {
+        (*static_cast<const Function*>(context))(begin, end);
+    }
+
+    void push(JobCounter& counter, const Job& job);
+    bool tryRunJob(std::size_t queueIndex);
+    void execute(const Job& job);
+    void workerLoop(std::size_t queueIndex);
+    // The calling thread's queue, 0 for the owner thread (or any thread that is not a worker)
+    std::size_t getQueueIndex() const;
+
+    std::vector<std::unique_ptr<JobQueue>> m_queues;
+    std::vector<std::thread> m_workers;
+
+    // Jobs pushed and not taken yet: workers sleep while it is 0
+    std::atomic<std::size_t> m_queuedJobCount{ 0 };
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wakeCondition;
+    bool m_isStopping = false; // guarded by m_wakeMutex
+};
@@ -0,0 +1,70 @@
+#include "LevelArena.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+LevelArena::LevelArena(std::size_t blockSize)
+    : m_blockSize(blockSize)
+{
+}
+
+LevelArena::~LevelArena()
+{
+    reset();
+}
+
+void LevelArena::reset()
+{
+    while (m_destructors)
+    {
+        Destructor* destructor = m_destructors;
+        m_destructors = destructor->next;
+        destructor->destroy(destructor->object);
+    }
+
+    m_currentBlock = 0;
+    m_offset = 0;
+    m_bytesUsed = 0;
+}
+
+void LevelArena::release()
+{
+    reset();
+    m_blocks.clear();
+}
+
+std::size_t LevelArena::getCapacity() const
+{
+    std::size_t capacity = 0;
+    for (const Block& block : m_blocks)
+        capacity += block.size;
+    return capacity;
+}
+
+void* LevelArena::do_allocate(std::size_t bytes, std::size_t alignment)
+{
+    // First block from the current one with enough room left; big requests get a block of their own
+    for (; m_currentBlock < m_blocks.size(); ++m_currentBlock, m_offset = 0)
+    {
+        const Block& block = m_blocks[m_currentBlock];
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(block.data.get()) + m_offset;
+        const std::size_t padding = (alignment - address % alignment) % alignment;
+        if (m_offset + padding + bytes <= block.size)
+        {
+            m_offset += padding + bytes;
+            m_bytesUsed += bytes;
+            return block.data.get() + m_offset - bytes;
+        }
+    }
+
+    // operator new[] aligns to __STDCPP_DEFAULT_NEW_ALIGNMENT__, more than any level data needs
+    if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+        throw std::bad_alloc();
+
+    const std::size_t size = std::max(m_blockSize, bytes);
+    m_blocks.push_back({ std::make_unique<std::byte[]>(size), size });
+    m_currentBlock = m_blocks.size() - 1;
+    m_offset = bytes;
+    m_bytesUsed += bytes;
+    return m_blocks.back().data.get();
+}
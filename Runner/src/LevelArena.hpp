@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Monotonic allocator for everything that lives exactly as long as a level.
+// Allocating bumps a pointer in the current block; nothing is freed one by one.
+// reset() destroys every object created with create() (in reverse order) and rewinds
+// the arena in one go. The blocks are kept, so the next level reuses the same memory.
+// It is also a std::pmr::memory_resource, for pmr containers owned by the level.
+class LevelArena : public std::pmr::memory_resource
+{
+public:
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    explicit LevelArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~LevelArena() override;
+
+    LevelArena(const LevelArena&) = delete;
+    LevelArena& operator=(const LevelArena&) = delete;
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T));
+        T* object = ::new (memory) T(std::forward<Args>(args)...);
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            m_destructors = ::new (allocate(sizeof(Destructor), alignof(Destructor))) Destructor{ &destroy<T>, object, m_destructors };
+        return object;
+    }
+
+    void reset();
+    // reset() and gives the blocks back to the system
+    void release();
+
+    std::size_t getBytesUsed() const { return m_bytesUsed; }
+    std::size_t getCapacity() const;
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size;
+    };
+
+    struct Destructor
+    {
+        void (*destroy)(void*);
+        void* object;
+        Destructor* next;
+    };
+
+    template <typename T>
+    static void destroy(void* object)
+    {
+        static_cast<T*>(object)->~T();
+    }
+
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+    void do_deallocate(void*, std::size_t, std::size_t) override {} // freed by reset()
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    const std::size_t m_blockSize;
+    std::vector<Block> m_blocks;
+    std::size_t m_currentBlock = 0;
+    std::size_t m_offset = 0; // in the current block
+    std::size_t m_bytesUsed = 0;
+    Destructor* m_destructors = nullptr; // most recent first
+};
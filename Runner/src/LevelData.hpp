@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Levels are cut into horizontal chunks of getChunkWidth() logical pixels.
+// Entity positions are stored relative to the left edge of their chunk, so the
+// same chunk can be placed anywhere (the infinite map loops over the level's chunks).
+
+// Fixed-size entity placement, as stored in level files
+struct LevelEntityRecord
+{
+    std::int32_t entityUID;
+    float x;
+    float y;
+
+    bool operator==(const LevelEntityRecord&) const = default;
+};
+static_assert(sizeof(LevelEntityRecord) == 12, "LevelEntityRecord is a file format record");
+
+struct LevelChunk
+{
+    int index = -1;
+    std::vector<LevelEntityRecord> entities;
+};
+
+// Where the LevelStreamer reads chunks from. readChunk() is called from the
+// streamer's loader thread only, never concurrently.
+class LevelChunkSource
+{
+public:
+    virtual ~LevelChunkSource() = default;
+
+    virtual int getLevelUID() const = 0;
+    virtual float getChunkWidth() const = 0;
+    virtual int getChunkCount() const = 0;
+
+    // Replaces the content of entities with the chunk's records
+    virtual void readChunk(int chunkIndex, std::vector<LevelEntityRecord>& entities) = 0;
+
+    // Sources already holding their records in memory (a mapped file) return true and
+    // give direct access to them: the streamer then spawns from them, with no copy and no loader thread.
+    virtual bool canViewChunks() const { return false; }
+    virtual std::span<const LevelEntityRecord> viewChunk(int /*chunkIndex*/) const { return {}; }
+};
@@ -0,0 +1,90 @@
+#include "LevelManager.hpp"
+
+#include <iostream>
+
+#include "BinaryLevelSource.hpp"
+#include "EntityManager.hpp"
+#include "Profiler.hpp"
+#include "TextLevelSource.hpp"
+
+std::filesystem::path LevelManager::getLevelPath(int levelUID)
+{
+    return std::filesystem::path("levels") / ("level_" + std::to_string(levelUID) + ".txt");
+}
+
+std::filesystem::path LevelManager::getBinaryLevelPath(int levelUID)
+{
+    return std::filesystem::path(getLevelPath(levelUID)).replace_extension(".rlvl");
+}
+
+std::filesystem::path LevelManager::chooseLevelFile(const std::filesystem::path& textPath, const std::filesystem::path& binaryPath)
+{
+    if (!std::filesystem::exists(binaryPath))
+        return textPath;
+    if (!std::filesystem::exists(textPath))
+        return binaryPath;
+
+    if (std::filesystem::last_write_time(binaryPath) < std::filesystem::last_write_time(textPath))
+    {
+        std::cerr << "LevelManager: " << binaryPath.string() << " is older than " << textPath.string()
+            << ", loading the text level (recompile it with --compile-level)" << std::endl;
+        return textPath;
+    }
+    return binaryPath;
+}
+
+void LevelManager::load(int levelUID, bool isInfinite)
+{
+    if (m_isLoaded && levelUID == m_currentLevelUID)
+    {
+        m_isInfinite = isInfinite;
+        restart();
+        return;
+    }
+
+    unload();
+
+    parseLevelFile(chooseLevelFile(getLevelPath(levelUID), getBinaryLevelPath(levelUID)).string());
+    m_currentLevelUID = levelUID;
+    m_isInfinite = isInfinite;
+    m_isLoaded = true;
+
+    restart();
+}
+
+void LevelManager::unload()
+{
+    m_streamer.stop();
+    m_source = nullptr;
+    m_arena.reset();
+    m_isLoaded = false;
+    m_currentLevelUID = -1;
+    m_elapsedTime = 0.f;
+}
+
+void LevelManager::restart()
+{
+    if (!m_isLoaded)
+        return;
+
+    m_elapsedTime = 0.f;
+    m_streamer.start(*m_source, m_isInfinite);
+}
+
+void LevelManager::update(float deltaTime, const sf::FloatRect& cameraRect, EntityManager& entityManager)
+{
+    if (!m_isLoaded)
+        return;
+
+    PROFILE_SCOPE(ProfileZone::LevelStreaming);
+    m_elapsedTime += deltaTime;
+    m_streamer.update(cameraRect, entityManager);
+}
+
+void LevelManager::parseLevelFile(const std::string& filePath)
+{
+    if (std::filesystem::path(filePath).extension() == ".rlvl")
+        m_source = m_arena.create<BinaryLevelSource>(filePath);
+    else
+        m_source = m_arena.create<TextLevelSource>(filePath, &m_arena);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include "LevelArena.hpp"
+#include "LevelData.hpp"
+#include "LevelStreamer.hpp"
+
+class EntityManager;
+
+// Loads levels and feeds their entities to the EntityManager.
+// Loading only opens the level file; the entities themselves are streamed in
+// chunks around the camera by the LevelStreamer.
+// The compiled binary level is preferred when it is up to date: it is memory-mapped and
+// spawned from in place, so loading and restarting cost almost nothing.
+// Everything owned by the level is allocated in a LevelArena, freed at once by unload().
+class LevelManager
+{
+public:
+    // levels/level_<levelUID>.txt
+    static std::filesystem::path getLevelPath(int levelUID);
+    // levels/level_<levelUID>.rlvl (see compileLevel())
+    static std::filesystem::path getBinaryLevelPath(int levelUID);
+    // The binary level, unless it is missing or older than the text level (it was not
+    // recompiled after an edit): then the text level, with a warning for the stale binary
+    static std::filesystem::path chooseLevelFile(const std::filesystem::path& textPath, const std::filesystem::path& binaryPath);
+
+    // Reloading the current level keeps its file open and only restarts it
+    void load(int levelUID, bool isInfinite = false);
+    void unload();
+    // Starts the current level over (after a death), without reopening the file
+    void restart();
+
+    // Called once per tick, at the tick boundary
+    void update(float deltaTime, const sf::FloatRect& cameraRect, EntityManager& entityManager);
+
+    bool isLoaded() const { return m_isLoaded; }
+    int getCurrentLevelUID() const { return m_currentLevelUID; }
+    bool isInfinite() const { return m_isInfinite; }
+    float getElapsedTime() const { return m_elapsedTime; }
+    const LevelStreamer& getStreamer() const { return m_streamer; }
+    const LevelArena& getArena() const { return m_arena; }
+
+private:
+    // Opens the file (binary levels are mapped, text levels indexed) (called in load())
+    void parseLevelFile(const std::string& filePath);
+
+    bool m_isLoaded = false;
+    bool m_isInfinite = false;
+    int m_currentLevelUID = -1;
+    float m_elapsedTime = 0.f;
+
+    LevelArena m_arena;
+    LevelChunkSource* m_source = nullptr; // lives in m_arena
+    LevelStreamer m_streamer;
+};
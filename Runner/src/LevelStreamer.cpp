@@ -0,0 +1,203 @@
+#include "LevelStreamer.hpp"
+
+#include <utility>
+
+#include "EntityManager.hpp"
+#include "Profiler.hpp"
+
+LevelStreamer::~LevelStreamer()
+{
+    stop();
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+    m_requestCondition.notify_all();
+    if (m_loader.joinable())
+        m_loader.join();
+}
+
+void LevelStreamer::start(LevelChunkSource& source, bool isInfinite)
+{
+    stop();
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_source = &source;
+    }
+    m_isInfinite = isInfinite;
+    m_chunkWidth = source.getChunkWidth();
+    m_isViewingChunks = source.canViewChunks();
+
+    // Mapped sources are read in place by the main thread, nothing to load in the background
+    if (m_isViewingChunks)
+        return;
+
+    if (!m_loader.joinable())
+        m_loader = std::thread(&LevelStreamer::loaderLoop, this);
+}
+
+void LevelStreamer::stop()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        // A chunk being read belongs to this run, and its source may be destroyed once stop() returns
+        m_readyCondition.wait(lock, [this] { return !m_isLoading; });
+
+        m_requests.clear();
+        for (LevelChunk& chunk : m_readyChunks)
+            m_freeChunks.push_back(std::move(chunk));
+        m_readyChunks.clear();
+        m_loaderError = nullptr;
+        m_source = nullptr;
+    }
+
+    for (LoadedChunk& loadedChunk : m_loadedChunks)
+    {
+        loadedChunk.handles.clear();
+        m_freeHandleLists.push_back(std::move(loadedChunk.handles));
+    }
+    m_loadedChunks.clear();
+
+    m_isViewingChunks = false;
+    m_nextChunkToRequest = 0;
+    m_nextChunkToSpawn = 0;
+}
+
+void LevelStreamer::update(const sf::FloatRect& cameraRect, EntityManager& entityManager)
+{
+    if (!m_source)
+        return;
+
+    const float cameraLeft = cameraRect.position.x;
+    const float cameraRight = cameraRect.position.x + cameraRect.size.x;
+
+    if (!m_isViewingChunks)
+        requestChunksUntil(cameraRight + (1 + PREFETCH_CHUNKS) * m_chunkWidth);
+
+    // Spawn, in order, every chunk starting less than one chunk after the camera
+    while (hasChunk(m_nextChunkToSpawn) && static_cast<float>(m_nextChunkToSpawn) * m_chunkWidth < cameraRight + m_chunkWidth)
+    {
+        LoadedChunk loadedChunk{ m_nextChunkToSpawn, {} };
+        if (!m_freeHandleLists.empty())
+        {
+            loadedChunk.handles = std::move(m_freeHandleLists.back());
+            m_freeHandleLists.pop_back();
+        }
+        const sf::Vector2f offset = { static_cast<float>(loadedChunk.index) * m_chunkWidth, 0.f };
+
+        if (m_isViewingChunks)
+        {
+            entityManager.spawnEntities(m_source->viewChunk(loadedChunk.index % m_source->getChunkCount()), offset, loadedChunk.handles);
+        }
+        else
+        {
+            LevelChunk chunk = waitForChunk(loadedChunk.index);
+            entityManager.spawnEntities(chunk.entities, offset, loadedChunk.handles);
+
+            std::lock_guard lock(m_mutex);
+            m_freeChunks.push_back(std::move(chunk));
+        }
+
+        m_loadedChunks.push_back(std::move(loadedChunk));
+        ++m_nextChunkToSpawn;
+    }
+
+    // Despawn the chunks entirely behind the camera, their slots go back to the EntityManager
+    while (!m_loadedChunks.empty() && static_cast<float>(m_loadedChunks.front().index + 1) * m_chunkWidth < cameraLeft)
+    {
+        std::vector<EntityHandle>& handles = m_loadedChunks.front().handles;
+        for (const EntityHandle handle : handles)
+            entityManager.destroyEntity(handle); // already destroyed entities are ignored
+        handles.clear();
+        m_freeHandleLists.push_back(std::move(handles));
+        m_loadedChunks.erase(m_loadedChunks.begin());
+    }
+}
+
+bool LevelStreamer::hasChunk(int chunkIndex) const
+{
+    const int chunkCount = m_source->getChunkCount();
+    return chunkCount > 0 && (m_isInfinite || chunkIndex < chunkCount);
+}
+
+void LevelStreamer::requestChunksUntil(float x)
+{
+    bool hasRequested = false;
+    {
+        std::lock_guard lock(m_mutex);
+        while (hasChunk(m_nextChunkToRequest) && static_cast<float>(m_nextChunkToRequest) * m_chunkWidth < x)
+        {
+            m_requests.push_back(m_nextChunkToRequest++);
+            hasRequested = true;
+        }
+    }
+    if (hasRequested)
+        m_requestCondition.notify_one();
+}
+
+LevelChunk LevelStreamer::waitForChunk(int chunkIndex)
+{
+    std::unique_lock lock(m_mutex);
+    m_readyCondition.wait(lock, [this, chunkIndex] {
+        return m_loaderError || (!m_readyChunks.empty() && m_readyChunks.front().index == chunkIndex);
+    });
+    if (m_loaderError)
+        std::rethrow_exception(m_loaderError);
+
+    LevelChunk chunk = std::move(m_readyChunks.front());
+    m_readyChunks.erase(m_readyChunks.begin());
+    return chunk;
+}
+
+void LevelStreamer::loaderLoop()
+{
+    PROFILE_THREAD_NAME("Level loader");
+
+    std::unique_lock lock(m_mutex);
+    for (;;)
+    {
+        m_requestCondition.wait(lock, [this] { return m_isShuttingDown || !m_requests.empty(); });
+        if (m_isShuttingDown)
+            return;
+
+        LevelChunk chunk;
+        chunk.index = m_requests.front();
+        m_requests.erase(m_requests.begin());
+        if (!m_freeChunks.empty())
+        {
+            chunk.entities = std::move(m_freeChunks.back().entities);
+            m_freeChunks.pop_back();
+        }
+        // stop() waits for m_isLoading to drop before it lets go of the source
+        LevelChunkSource& source = *m_source;
+        m_isLoading = true;
+        lock.unlock();
+
+        std::exception_ptr error;
+        try
+        {
+            PROFILE_SCOPE(ProfileZone::LevelStreaming);
+            source.readChunk(chunk.index % source.getChunkCount(), chunk.entities);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        m_isLoading = false;
+        if (error)
+        {
+            // Kept until the next stop(): every later wait rethrows it
+            m_loaderError = error;
+            m_freeChunks.push_back(std::move(chunk));
+        }
+        else
+        {
+            m_readyChunks.push_back(std::move(chunk));
+        }
+        m_readyCondition.notify_all();
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+
+#include "Entity.hpp"
+#include "LevelData.hpp"
+
+class EntityManager;
+
+// Streams a level chunk by chunk around the camera.
+// A loader thread parses the chunks PREFETCH_CHUNKS ahead of the camera; the main
+// thread spawns a parsed chunk as one batch, at a tick boundary, once its left edge
+// comes within one chunk of the camera's right edge, and despawns the chunks left
+// behind. Spawning depends only on the camera position (the main thread waits for
+// the loader if it is late), so a replay spawns the same entities at the same tick.
+// Chunk buffers and handle lists are recycled: memory stays flat however long the run.
+// The loader thread is started by the first start() and lives as long as the streamer:
+// a restart only empties its queues.
+// Sources that can view their chunks in place (BinaryLevelSource) skip the loader
+// thread: their records are spawned straight from the mapped file.
+class LevelStreamer
+{
+public:
+    static constexpr int PREFETCH_CHUNKS = 2;
+
+    LevelStreamer() = default;
+    ~LevelStreamer();
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // In infinite mode the level's chunks are repeated forever
+    void start(LevelChunkSource& source, bool isInfinite);
+    // Forgets every loaded chunk (their entities are left to the caller, usually EntityManager::clear())
+    void stop();
+
+    // Called by the main thread once per tick
+    void update(const sf::FloatRect& cameraRect, EntityManager& entityManager);
+
+    std::size_t getLoadedChunkCount() const { return m_loadedChunks.size(); }
+    int getSpawnedChunkCount() const { return m_nextChunkToSpawn; }
+
+private:
+    struct LoadedChunk
+    {
+        int index;
+        std::vector<EntityHandle> handles;
+    };
+
+    bool hasChunk(int chunkIndex) const;
+    void requestChunksUntil(float x);
+    LevelChunk waitForChunk(int chunkIndex);
+    void loaderLoop();
+
+    LevelChunkSource* m_source = nullptr; // written under m_mutex, the loader reads it too
+    bool m_isInfinite = false;
+    bool m_isViewingChunks = false;
+    float m_chunkWidth = 0.f;
+    int m_nextChunkToRequest = 0;
+    int m_nextChunkToSpawn = 0;
+
+    // Shared with the loader thread, guarded by m_mutex
+    std::thread m_loader;
+    std::mutex m_mutex;
+    std::condition_variable m_requestCondition;
+    std::condition_variable m_readyCondition;
+    bool m_isShuttingDown = false;
+    bool m_isLoading = false; // reading a chunk out of the lock
+    std::vector<int> m_requests;          // FIFO, in chunk order
+    std::vector<LevelChunk> m_readyChunks; // FIFO, in chunk order
+    std::vector<LevelChunk> m_freeChunks;
+    std::exception_ptr m_loaderError;
+
+    // Main thread only
+    std::vector<LoadedChunk> m_loadedChunks; // in chunk order
+    std::vector<std::vector<EntityHandle>> m_freeHandleLists;
+};
@@ -0,0 +1,141 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const std::filesystem::path& filePath)
+{
+    open(filePath);
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    swap(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        close();
+        swap(other);
+    }
+    return *this;
+}
+
+void MappedFile::swap(MappedFile& other) noexcept
+{
+    std::swap(m_data, other.m_data);
+    std::swap(m_size, other.m_size);
+#ifdef _WIN32
+    std::swap(m_fileHandle, other.m_fileHandle);
+    std::swap(m_mappingHandle, other.m_mappingHandle);
+#endif
+}
+
+#ifdef _WIN32
+
+void MappedFile::open(const std::filesystem::path& filePath)
+{
+    close();
+
+    const std::string error = "MappedFile: cannot map " + filePath.string();
+
+    HANDLE file = CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::runtime_error(error);
+
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        throw std::runtime_error(error + " (empty file)");
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view)
+    {
+        if (mapping)
+            CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::runtime_error(error);
+    }
+
+    m_fileHandle = file;
+    m_mappingHandle = mapping;
+    m_data = static_cast<const std::byte*>(view);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+    if (m_mappingHandle)
+        CloseHandle(m_mappingHandle);
+    if (m_fileHandle)
+        CloseHandle(m_fileHandle);
+
+    m_data = nullptr;
+    m_size = 0;
+    m_fileHandle = nullptr;
+    m_mappingHandle = nullptr;
+}
+
+#else
+
+void MappedFile::open(const std::filesystem::path& filePath)
+{
+    close();
+
+    const std::string error = "MappedFile: cannot map " + filePath.string();
+
+    const int file = ::open(filePath.c_str(), O_RDONLY);
+    if (file < 0)
+        throw std::runtime_error(error);
+
+    struct stat status{};
+    if (fstat(file, &status) != 0 || status.st_size == 0)
+    {
+        ::close(file);
+        throw std::runtime_error(error + " (empty file)");
+    }
+
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file); // the mapping keeps its own reference to the file
+    if (view == MAP_FAILED)
+        throw std::runtime_error(error);
+
+    m_data = static_cast<const std::byte*>(view);
+    m_size = size;
+}
+
+void MappedFile::close()
+{
+    if (m_data)
+        munmap(const_cast<std::byte*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+#endif
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+
+// Read-only memory mapping of a whole file (CreateFileMapping on Windows, mmap elsewhere).
+// The mapping stays valid until the MappedFile is closed or destroyed.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    // Throws if the file cannot be opened or mapped
+    explicit MappedFile(const std::filesystem::path& filePath);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    void open(const std::filesystem::path& filePath);
+    void close();
+
+    bool isOpen() const { return m_data != nullptr; }
+    const std::byte* getData() const { return m_data; }
+    std::size_t getSize() const { return m_size; }
+
+private:
+    void swap(MappedFile& other) noexcept;
+
+    const std::byte* m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
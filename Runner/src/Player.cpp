@@ -0,0 +1,48 @@
+#include "Player.hpp"
+
+#include <algorithm>
+
+#include "EntityManager.hpp"
+
+void Player::spawn(EntityManager& entityManager, sf::Vector2f position)
+{
+    m_handle = entityManager.spawnEntity(entityUIDOf(EntityType::Player), position);
+    m_runSpeed = START_RUN_SPEED;
+}
+
+void Player::handleInputs(const InputState& input, EntityManager& entityManager) const
+{
+    if (!entityManager.isAlive(m_handle))
+        return;
+
+    sf::Vector2f direction;
+    if (input.isPressed(InputAction::Up))
+        direction.y -= 1.f;
+    if (input.isPressed(InputAction::Down))
+        direction.y += 1.f;
+    if (input.isPressed(InputAction::Left))
+        direction.x -= 1.f;
+    if (input.isPressed(InputAction::Right))
+        direction.x += 1.f;
+
+    entityManager.setVelocity(m_handle, { m_runSpeed + direction.x * MOVE_SPEED, direction.y * MOVE_SPEED });
+}
+
+void Player::update(float deltaTime)
+{
+    m_runSpeed = std::min(m_runSpeed + RUN_ACCELERATION * deltaTime, MAX_RUN_SPEED);
+}
+
+void Player::clampTo(const sf::FloatRect& bounds, EntityManager& entityManager) const
+{
+    if (!entityManager.isAlive(m_handle))
+        return;
+
+    const sf::FloatRect hitbox = entityManager.getHitbox(m_handle);
+    const sf::Vector2f position = {
+        std::clamp(hitbox.position.x, bounds.position.x, bounds.position.x + bounds.size.x - hitbox.size.x),
+        std::clamp(hitbox.position.y, bounds.position.y, bounds.position.y + bounds.size.y - hitbox.size.y)
+    };
+    if (position != hitbox.position)
+        entityManager.setPosition(m_handle, position);
+}
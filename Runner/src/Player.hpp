@@ -0,0 +1,36 @@
+#pragma once
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "Entity.hpp"
+#include "InputState.hpp"
+
+class EntityManager;
+
+// The player's entity lives in the EntityManager like every other one;
+// this class only holds what is specific to controlling it.
+class Player
+{
+public:
+    void spawn(EntityManager& entityManager, sf::Vector2f position);
+
+    // Auto-run speed plus the four directions movement asked by the inputs
+    void handleInputs(const InputState& input, EntityManager& entityManager) const;
+    // Run speed increases with time, up to a cap
+    void update(float deltaTime);
+    // Keeps the player inside the camera
+    void clampTo(const sf::FloatRect& bounds, EntityManager& entityManager) const;
+
+    EntityHandle getHandle() const { return m_handle; }
+    float getRunSpeed() const { return m_runSpeed; }
+
+private:
+    static constexpr float START_RUN_SPEED = 400.f;
+    static constexpr float MAX_RUN_SPEED = 900.f;
+    static constexpr float RUN_ACCELERATION = 10.f;
+    static constexpr float MOVE_SPEED = 500.f;
+
+    EntityHandle m_handle;
+    float m_runSpeed = START_RUN_SPEED;
+};
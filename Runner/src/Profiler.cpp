@@ -0,0 +1,224 @@
+#include "Profiler.hpp"
+
+#ifdef RUNNER_PROFILING
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <mutex>
+#include <stdexcept>
+
+namespace
+{
+    const char* const ZONE_NAMES[PROFILE_ZONE_COUNT] = { "Update", "Collision", "Draw", "UI", "LevelStreaming" };
+
+    const std::chrono::steady_clock::time_point PROFILER_EPOCH = std::chrono::steady_clock::now();
+
+    // Registered buffers, pushed at the front and never removed: readers walk the list
+    // without locking and a finished thread's last events can still be exported
+    std::atomic<ProfileBuffer*> g_firstBuffer{ nullptr };
+    std::atomic<std::uint32_t> g_threadCount{ 0 };
+
+    // Buffers of the threads that exited, handed to the next threads that start
+    std::mutex g_freeBuffersMutex;
+    std::vector<ProfileBuffer*> g_freeBuffers;
+
+    // Gives the buffer back when its thread exits
+    struct ThreadBufferOwner
+    {
+        ProfileBuffer* buffer;
+
+        ~ThreadBufferOwner()
+        {
+            std::lock_guard lock(g_freeBuffersMutex);
+            g_freeBuffers.push_back(buffer);
+        }
+    };
+
+    double toMicroseconds(std::uint64_t nanoseconds)
+    {
+        return static_cast<double>(nanoseconds) / 1000.0;
+    }
+}
+
+const char* getProfileZoneName(ProfileZone zone)
+{
+    const std::size_t index = static_cast<std::size_t>(zone);
+    return index < PROFILE_ZONE_COUNT ? ZONE_NAMES[index] : "Unknown";
+}
+
+void ProfileBuffer::push(const ProfileEvent& event)
+{
+    const std::uint64_t index = m_writeCount.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[index % CAPACITY];
+
+    // Readers that copy this slot meanwhile see the odd sequence and drop it
+    slot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.start.store(event.start, std::memory_order_relaxed);
+    slot.end.store(event.end, std::memory_order_relaxed);
+    slot.zone.store(event.zone, std::memory_order_relaxed);
+    slot.sequence.store(2 * index + 2, std::memory_order_release);
+
+    m_writeCount.store(index + 1, std::memory_order_release);
+}
+
+bool ProfileBuffer::tryRead(std::uint64_t index, ProfileEvent& event) const
+{
+    const Slot& slot = m_slots[index % CAPACITY];
+    const std::uint64_t written = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != written)
+        return false;
+
+    event.start = slot.start.load(std::memory_order_relaxed);
+    event.end = slot.end.load(std::memory_order_relaxed);
+    event.zone = slot.zone.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == written;
+}
+
+std::uint64_t Profiler::now()
+{
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - PROFILER_EPOCH).count());
+}
+
+ProfileBuffer& Profiler::getThreadBuffer()
+{
+    thread_local const ThreadBufferOwner owner{ []
+    {
+        {
+            std::lock_guard lock(g_freeBuffersMutex);
+            if (!g_freeBuffers.empty())
+            {
+                // Its write count goes on from the previous thread's, so readers' cursors stay valid
+                ProfileBuffer* freeBuffer = g_freeBuffers.back();
+                g_freeBuffers.pop_back();
+                freeBuffer->setThreadName(nullptr);
+                return freeBuffer;
+            }
+        }
+
+        ProfileBuffer* newBuffer = new ProfileBuffer(g_threadCount.fetch_add(1, std::memory_order_relaxed));
+        newBuffer->m_next = g_firstBuffer.load(std::memory_order_relaxed);
+        while (!g_firstBuffer.compare_exchange_weak(newBuffer->m_next, newBuffer, std::memory_order_release, std::memory_order_relaxed))
+        {
+        }
+        return newBuffer;
+    }() };
+    return *owner.buffer;
+}
+
+const ProfileBuffer* Profiler::getFirstBuffer()
+{
+    return g_firstBuffer.load(std::memory_order_acquire);
+}
+
+void Profiler::setThreadName(const char* name)
+{
+    getThreadBuffer().setThreadName(name);
+}
+
+std::uint64_t& ProfileReader::getCursor(const ProfileBuffer& buffer)
+{
+    for (auto& [cursorBuffer, cursor] : m_cursors)
+    {
+        if (cursorBuffer == &buffer)
+            return cursor;
+    }
+    return m_cursors.emplace_back(&buffer, 0).second;
+}
+
+void ProfileHistory::endFrame()
+{
+    Frame& frame = m_frames[m_nextFrame];
+    frame.fill(0.0f);
+    m_reader.readNewEvents([&frame](const ProfileBuffer&, const ProfileEvent& event)
+    {
+        frame[static_cast<std::size_t>(event.zone)] += static_cast<float>(event.end - event.start) / 1'000'000.0f;
+    });
+    m_nextFrame = (m_nextFrame + 1) % HISTORY_SIZE;
+}
+
+float ProfileHistory::getAverage(ProfileZone zone) const
+{
+    float total = 0.0f;
+    for (const Frame& frame : m_frames)
+        total += frame[static_cast<std::size_t>(zone)];
+    return total / static_cast<float>(HISTORY_SIZE);
+}
+
+ChromeTraceWriter::~ChromeTraceWriter()
+{
+    if (isOpen())
+        close();
+}
+
+void ChromeTraceWriter::open(const std::filesystem::path& filePath)
+{
+    if (isOpen())
+        close();
+
+    m_file.open(filePath, std::ios::trunc);
+    if (!m_file)
+        throw std::runtime_error("Cannot create trace file " + filePath.string());
+
+    // Events already in the buffers belong to the trace too
+    m_reader = ProfileReader();
+    m_namedThreads.clear();
+    m_isFirstEvent = true;
+    // Microseconds with nanosecond digits, never in exponent notation
+    m_file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+}
+
+void ChromeTraceWriter::flush()
+{
+    if (!isOpen())
+        return;
+
+    // Thread names are metadata events, written once the thread has named itself
+    for (const ProfileBuffer* buffer = Profiler::getFirstBuffer(); buffer; buffer = buffer->getNext())
+    {
+        const char* name = buffer->getThreadName();
+        const auto namedThread = std::find_if(m_namedThreads.begin(), m_namedThreads.end(),
+            [buffer](const auto& entry) { return entry.first == buffer; });
+        if (!name || (namedThread != m_namedThreads.end() && namedThread->second == name))
+            continue;
+
+        writeSeparator();
+        m_file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->getThreadIndex()
+               << ",\"args\":{\"name\":\"" << name << "\"}}";
+        if (namedThread != m_namedThreads.end())
+            namedThread->second = name;
+        else
+            m_namedThreads.emplace_back(buffer, name);
+    }
+
+    m_reader.readNewEvents([this](const ProfileBuffer& buffer, const ProfileEvent& event)
+    {
+        writeSeparator();
+        m_file << "{\"name\":\"" << getProfileZoneName(event.zone) << "\",\"cat\":\"runner\",\"ph\":\"X\",\"ts\":"
+               << toMicroseconds(event.start) << ",\"dur\":" << toMicroseconds(event.end - event.start)
+               << ",\"pid\":1,\"tid\":" << buffer.getThreadIndex() << "}";
+    });
+    m_file.flush();
+}
+
+void ChromeTraceWriter::close()
+{
+    if (!isOpen())
+        return;
+
+    flush();
+    m_file << "]}\n";
+    m_file.close();
+}
+
+void ChromeTraceWriter::writeSeparator()
+{
+    // One event per line keeps long traces readable and diffable
+    m_file << (m_isFirstEvent ? "\n" : ",\n");
+    m_isFirstEvent = false;
+}
+
+#endif
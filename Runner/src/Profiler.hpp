@@ -0,0 +1,218 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+// Scoped timers for the main subsystems:
+//
+//     void EntityManager::updateAll(float deltaTime)
+//     {
+//         PROFILE_SCOPE(ProfileZone::Update);
+//         ...
+//
+// Each thread writes its timings to its own ring buffer, without locks: the owner
+// thread is the only writer, readers (the overlay, the trace export) only follow
+// an atomic write count. Without RUNNER_PROFILING defined, PROFILE_SCOPE expands
+// to nothing and this header declares nothing else.
+
+enum class ProfileZone : std::uint8_t
+{
+    Update,
+    Collision,
+    Draw,
+    UI,
+    LevelStreaming,
+    Count
+};
+
+constexpr std::size_t PROFILE_ZONE_COUNT = static_cast<std::size_t>(ProfileZone::Count);
+
+#ifdef RUNNER_PROFILING
+
+const char* getProfileZoneName(ProfileZone zone);
+
+class ProfileBuffer;
+
+namespace Profiler
+{
+    // The calling thread's buffer, taken on first use. Buffers outlive their thread and
+    // go to the next thread that starts: restarting a thread does not add a buffer.
+    ProfileBuffer& getThreadBuffer();
+}
+
+// Nanoseconds, start and end since the profiler's epoch
+struct ProfileEvent
+{
+    std::uint64_t start;
+    std::uint64_t end;
+    ProfileZone zone;
+};
+
+// Ring buffer of one thread's events. Single writer; any thread may read.
+class ProfileBuffer
+{
+public:
+    static constexpr std::size_t CAPACITY = 1 << 14;
+
+    explicit ProfileBuffer(std::uint32_t threadIndex) : m_threadIndex(threadIndex) {}
+
+    // Owner thread only. Overwrites the oldest event when full.
+    void push(const ProfileEvent& event);
+
+    // Number of events pushed by every thread that owned the buffer (not capped by CAPACITY)
+    std::uint64_t getWriteCount() const { return m_writeCount.load(std::memory_order_acquire); }
+    // Copies the event number index. False if it was overwritten (or is being) by the writer.
+    bool tryRead(std::uint64_t index, ProfileEvent& event) const;
+
+    std::uint32_t getThreadIndex() const { return m_threadIndex; }
+    const char* getThreadName() const { return m_threadName.load(std::memory_order_acquire); }
+    void setThreadName(const char* name) { m_threadName.store(name, std::memory_order_release); }
+    const ProfileBuffer* getNext() const { return m_next; }
+
+private:
+    friend ProfileBuffer& Profiler::getThreadBuffer();
+
+    // sequence is 2 * index + 1 while event index is written, 2 * index + 2 once written
+    struct Slot
+    {
+        std::atomic<std::uint64_t> sequence{ 0 };
+        std::atomic<std::uint64_t> start{ 0 };
+        std::atomic<std::uint64_t> end{ 0 };
+        std::atomic<ProfileZone> zone{ ProfileZone::Update };
+    };
+
+    std::array<Slot, CAPACITY> m_slots;
+    std::atomic<std::uint64_t> m_writeCount{ 0 };
+    const std::uint32_t m_threadIndex;
+    std::atomic<const char*> m_threadName{ nullptr };
+    ProfileBuffer* m_next = nullptr; // registry list, set once before the buffer is published
+};
+
+namespace Profiler
+{
+    std::uint64_t now();
+
+    // Most recently registered first
+    const ProfileBuffer* getFirstBuffer();
+
+    // Shown in the trace; name must outlive the program (a string literal)
+    void setThreadName(const char* name);
+}
+
+class ScopedProfileTimer
+{
+public:
+    explicit ScopedProfileTimer(ProfileZone zone) : m_start(Profiler::now()), m_zone(zone) {}
+    ~ScopedProfileTimer() { Profiler::getThreadBuffer().push({ m_start, Profiler::now(), m_zone }); }
+
+    ScopedProfileTimer(const ScopedProfileTimer&) = delete;
+    ScopedProfileTimer& operator=(const ScopedProfileTimer&) = delete;
+
+private:
+    std::uint64_t m_start;
+    ProfileZone m_zone;
+};
+
+// Follows every thread's buffer and hands out the events pushed since the last read.
+// Used from one thread at a time.
+class ProfileReader
+{
+public:
+    template <typename Callback> // void(const ProfileBuffer&, const ProfileEvent&)
+    void readNewEvents(Callback&& callback)
+    {
+        for (const ProfileBuffer* buffer = Profiler::getFirstBuffer(); buffer; buffer = buffer->getNext())
+        {
+            std::uint64_t& cursor = getCursor(*buffer);
+            const std::uint64_t writeCount = buffer->getWriteCount();
+            if (writeCount - cursor > ProfileBuffer::CAPACITY)
+            {
+                m_droppedEventCount += writeCount - cursor - ProfileBuffer::CAPACITY;
+                cursor = writeCount - ProfileBuffer::CAPACITY;
+            }
+
+            ProfileEvent event;
+            for (; cursor < writeCount; ++cursor)
+            {
+                if (buffer->tryRead(cursor, event))
+                    callback(*buffer, event);
+                else
+                    ++m_droppedEventCount;
+            }
+        }
+    }
+
+    // Events overwritten before they could be read
+    std::uint64_t getDroppedEventCount() const { return m_droppedEventCount; }
+
+private:
+    std::uint64_t& getCursor(const ProfileBuffer& buffer);
+
+    std::vector<std::pair<const ProfileBuffer*, std::uint64_t>> m_cursors;
+    std::uint64_t m_droppedEventCount = 0;
+};
+
+// Time spent in each zone, per frame, over the last HISTORY_SIZE frames
+class ProfileHistory
+{
+public:
+    static constexpr std::size_t HISTORY_SIZE = 240;
+
+    using Frame = std::array<float, PROFILE_ZONE_COUNT>; // milliseconds
+
+    // Sums the events recorded since the previous call into a new frame
+    void endFrame();
+
+    // Oldest first
+    Frame getFrame(std::size_t age) const { return m_frames[(m_nextFrame + age) % HISTORY_SIZE]; }
+    // Mean over the history, in milliseconds
+    float getAverage(ProfileZone zone) const;
+
+private:
+    ProfileReader m_reader;
+    std::array<Frame, HISTORY_SIZE> m_frames{};
+    std::size_t m_nextFrame = 0;
+};
+
+// Streams the events to a Chrome trace file (chrome://tracing, Perfetto), so a whole
+// session can be captured: call flush() regularly, before the ring buffers wrap.
+class ChromeTraceWriter
+{
+public:
+    ~ChromeTraceWriter();
+
+    // Throws if the file cannot be created
+    void open(const std::filesystem::path& filePath);
+    void flush();
+    // Flushes and terminates the JSON document
+    void close();
+
+    bool isOpen() const { return m_file.is_open(); }
+    std::uint64_t getDroppedEventCount() const { return m_reader.getDroppedEventCount(); }
+
+private:
+    void writeSeparator();
+
+    std::ofstream m_file;
+    ProfileReader m_reader;
+    std::vector<std::pair<const ProfileBuffer*, const char*>> m_namedThreads; // a reused buffer is named again
+    bool m_isFirstEvent = true;
+};
+
+#define RUNNER_PROFILE_CONCAT_INNER(a, b) a##b
+#define RUNNER_PROFILE_CONCAT(a, b) RUNNER_PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(zone) const ScopedProfileTimer RUNNER_PROFILE_CONCAT(profileTimer, __LINE__)(zone)
+#define PROFILE_THREAD_NAME(name) Profiler::setThreadName(name)
+
+#else
+
+#define PROFILE_SCOPE(zone) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+
+#endif
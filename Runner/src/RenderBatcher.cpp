@@ -0,0 +1,108 @@
+#include "RenderBatcher.hpp"
+
+#include <algorithm>
+
+#include "EntityManager.hpp"
+
+namespace
+{
+    struct RenderLayer
+    {
+        int layer;
+        BlendLayer blend;
+    };
+
+    // Indexed by EntityType: collectibles at the back, player in front, glowing projectiles
+    constexpr std::array<RenderLayer, ENTITY_TYPE_COUNT> LAYER_OF_TYPE = { {
+        { 2, BlendLayer::Alpha },    // Player
+        { 1, BlendLayer::Alpha },    // Spike
+        { 1, BlendLayer::Alpha },    // MovingEnemy
+        { 1, BlendLayer::Additive }, // Projectile
+        { 0, BlendLayer::Alpha },    // Collectible
+    } };
+
+    void appendQuad(std::vector<sf::Vertex>& vertices, const sf::FloatRect& rect, const sf::FloatRect& textureRect)
+    {
+        const sf::Vector2f topLeft = rect.position;
+        const sf::Vector2f topRight = { rect.position.x + rect.size.x, rect.position.y };
+        const sf::Vector2f bottomLeft = { rect.position.x, rect.position.y + rect.size.y };
+        const sf::Vector2f bottomRight = rect.position + rect.size;
+
+        const sf::Vector2f textureTopLeft = textureRect.position;
+        const sf::Vector2f textureTopRight = { textureRect.position.x + textureRect.size.x, textureRect.position.y };
+        const sf::Vector2f textureBottomLeft = { textureRect.position.x, textureRect.position.y + textureRect.size.y };
+        const sf::Vector2f textureBottomRight = textureRect.position + textureRect.size;
+
+        vertices.push_back({ topLeft, sf::Color::White, textureTopLeft });
+        vertices.push_back({ topRight, sf::Color::White, textureTopRight });
+        vertices.push_back({ bottomLeft, sf::Color::White, textureBottomLeft });
+        vertices.push_back({ bottomLeft, sf::Color::White, textureBottomLeft });
+        vertices.push_back({ topRight, sf::Color::White, textureTopRight });
+        vertices.push_back({ bottomRight, sf::Color::White, textureBottomRight });
+    }
+}
+
+RenderBatcher::RenderBatcher()
+{
+    // One batch per distinct (layer, blend), in draw order
+    for (const RenderLayer& renderLayer : LAYER_OF_TYPE)
+    {
+        const bool isKnown = std::any_of(m_batches.begin(), m_batches.end(), [&renderLayer](const RenderBatch& batch) {
+            return batch.layer == renderLayer.layer && batch.blend == renderLayer.blend;
+        });
+        if (!isKnown)
+            m_batches.push_back({ renderLayer.layer, renderLayer.blend, {} });
+    }
+    std::sort(m_batches.begin(), m_batches.end(), [](const RenderBatch& a, const RenderBatch& b) {
+        return a.layer != b.layer ? a.layer < b.layer : a.blend < b.blend;
+    });
+
+    for (std::size_t type = 0; type < ENTITY_TYPE_COUNT; ++type)
+    {
+        const auto batch = std::find_if(m_batches.begin(), m_batches.end(), [type](const RenderBatch& candidate) {
+            return candidate.layer == LAYER_OF_TYPE[type].layer && candidate.blend == LAYER_OF_TYPE[type].blend;
+        });
+        m_batchOfType[type] = static_cast<std::size_t>(batch - m_batches.begin());
+    }
+
+    m_textureRects.fill(sf::FloatRect());
+}
+
+void RenderBatcher::setTextureRects(const std::array<sf::FloatRect, ENTITY_TYPE_COUNT>& textureRects)
+{
+    m_textureRects = textureRects;
+}
+
+void RenderBatcher::build(const EntityManager& entityManager, const sf::FloatRect& viewRect, float alpha)
+{
+    // clear() keeps the capacity, so a steady scene does not allocate
+    for (RenderBatch& batch : m_batches)
+        batch.vertices.clear();
+    m_stats = {};
+
+    const std::vector<sf::Vector2f>& previousPositions = entityManager.getPreviousPositions();
+    const std::vector<sf::Vector2f>& positions = entityManager.getPositions();
+    const std::vector<sf::FloatRect>& hitboxes = entityManager.getHitboxes();
+    const std::vector<EntityType>& types = entityManager.getTypes();
+
+    for (std::size_t i = 0; i < positions.size(); ++i)
+    {
+        const sf::FloatRect rect(previousPositions[i] + (positions[i] - previousPositions[i]) * alpha, hitboxes[i].size);
+        if (!isColliding(viewRect, rect))
+        {
+            ++m_stats.culledEntities;
+            continue;
+        }
+
+        const std::size_t type = static_cast<std::size_t>(types[i]);
+        appendQuad(m_batches[m_batchOfType[type]].vertices, rect, m_textureRects[type]);
+    }
+
+    for (const RenderBatch& batch : m_batches)
+    {
+        if (batch.vertices.empty())
+            continue;
+        ++m_stats.drawCalls;
+        m_stats.vertexCount += batch.vertices.size();
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+
+#include "Entity.hpp"
+
+class EntityManager;
+
+enum class BlendLayer
+{
+    Alpha,
+    Additive
+};
+
+// All the visible quads of one layer sharing one blend mode: a single draw call.
+struct RenderBatch
+{
+    int layer;
+    BlendLayer blend;
+    std::vector<sf::Vertex> vertices; // sf::PrimitiveType::Triangles, 6 per quad
+};
+
+struct RenderStats
+{
+    std::size_t drawCalls = 0;
+    std::size_t vertexCount = 0;
+    std::size_t culledEntities = 0;
+};
+
+// Turns the entities into one vertex array per (layer, blend mode), textured from the
+// atlas and culled to the stage view. Building is pure CPU work, Game only has to
+// issue one draw call per non-empty batch.
+class RenderBatcher
+{
+public:
+    RenderBatcher();
+
+    void setTextureRects(const std::array<sf::FloatRect, ENTITY_TYPE_COUNT>& textureRects);
+
+    // alpha interpolates between the previous and current entity positions
+    void build(const EntityManager& entityManager, const sf::FloatRect& viewRect, float alpha);
+
+    // Sorted by layer, then blend mode (draw order). Empty batches must be skipped.
+    const std::vector<RenderBatch>& getBatches() const { return m_batches; }
+    const RenderStats& getStats() const { return m_stats; }
+
+private:
+    std::vector<RenderBatch> m_batches;
+    std::array<std::size_t, ENTITY_TYPE_COUNT> m_batchOfType;
+    std::array<sf::FloatRect, ENTITY_TYPE_COUNT> m_textureRects;
+    RenderStats m_stats;
+};
@@ -0,0 +1,62 @@
+#include "Replay.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Simulation.hpp"
+
+ReplayResult replayRecording(const InputRecording& recording, sf::Vector2u logicalResolution, bool isTimingTicks,
+    JobSystem* jobSystem)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Simulation simulation(logicalResolution, recording.seed);
+    simulation.setJobSystem(jobSystem);
+    if (recording.levelUID >= 0)
+        simulation.loadLevel(recording.levelUID, recording.isInfinite);
+
+    ReplayResult result;
+    result.tickCount = recording.inputs.size();
+    if (isTimingTicks)
+        result.tickMilliseconds.reserve(recording.inputs.size());
+
+    const Clock::time_point start = Clock::now();
+    for (const InputState& input : recording.inputs)
+    {
+        if (isTimingTicks)
+        {
+            const Clock::time_point tickStart = Clock::now();
+            if (simulation.advance(input))
+                ++result.runCount;
+            result.tickMilliseconds.push_back(std::chrono::duration<double, std::milli>(Clock::now() - tickStart).count());
+        }
+        else if (simulation.advance(input))
+        {
+            ++result.runCount;
+        }
+    }
+    result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    result.finalStateHash = simulation.computeStateHash();
+    return result;
+}
+
+TickTimeSummary summarizeTickTimes(std::vector<double> tickMilliseconds)
+{
+    TickTimeSummary summary;
+    if (tickMilliseconds.empty())
+        return summary;
+
+    auto percentile = [&tickMilliseconds](double fraction)
+    {
+        const std::size_t rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(tickMilliseconds.size())));
+        const auto nth = tickMilliseconds.begin() + static_cast<std::ptrdiff_t>(std::max<std::size_t>(rank, 1) - 1);
+        std::nth_element(tickMilliseconds.begin(), nth, tickMilliseconds.end());
+        return *nth;
+    };
+
+    summary.p50 = percentile(0.50);
+    summary.p99 = percentile(0.99);
+    summary.max = *std::max_element(tickMilliseconds.begin(), tickMilliseconds.end());
+    return summary;
+}
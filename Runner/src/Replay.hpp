@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <SFML/System/Vector2.hpp>
+
+#include "InputRecording.hpp"
+
+class JobSystem;
+
+struct ReplayResult
+{
+    std::uint64_t tickCount = 0;
+    std::uint64_t runCount = 1; // a run ends when the player dies
+    double seconds = 0.0;
+    std::vector<double> tickMilliseconds; // duration of every tick, when timed
+    std::uint64_t finalStateHash = 0;
+
+    // 0 when the replay is too short to measure
+    double getTicksPerSecond() const { return seconds > 0.0 ? static_cast<double>(tickCount) / seconds : 0.0; }
+    // False if the recording has a final hash and the replay did not end in that state
+    bool matches(const InputRecording& recording) const
+    {
+        return recording.finalStateHash == 0 || recording.finalStateHash == finalStateHash;
+    }
+};
+
+struct TickTimeSummary
+{
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+// Rebuilds the recorded run without a window: a fresh Simulation with the recording's
+// seed and level, fed one recorded InputState per tick through Simulation::advance(),
+// the same path as the game loop. Throws if the recorded level cannot be loaded.
+// The simulation uses jobSystem if given: the final state must not depend on it.
+ReplayResult replayRecording(const InputRecording& recording, sf::Vector2u logicalResolution, bool isTimingTicks,
+    JobSystem* jobSystem = nullptr);
+
+// Percentiles in milliseconds (nearest rank)
+TickTimeSummary summarizeTickTimes(std::vector<double> tickMilliseconds);
@@ -0,0 +1,103 @@
+#include "Simulation.hpp"
+
+#include "StateHash.hpp"
+
+Simulation::Simulation(sf::Vector2u logicalResolution, std::uint32_t seed)
+    : m_logicalResolution(static_cast<sf::Vector2f>(logicalResolution)), m_seed(seed)
+{
+    m_entityManager.setLogicalResolution(logicalResolution);
+    startRun();
+}
+
+void Simulation::loadLevel(int levelUID, bool isInfinite)
+{
+    m_levelManager.load(levelUID, isInfinite);
+    m_endedRunsHash = 0;
+    startRun();
+}
+
+void Simulation::reset()
+{
+    m_levelManager.restart();
+    startRun();
+}
+
+void Simulation::tick(const InputState& input)
+{
+    // Chunks are spawned and despawned at the tick boundary only
+    m_levelManager.update(TICK_DURATION, getCameraRect(), m_entityManager);
+
+    m_player.handleInputs(input, m_entityManager);
+    m_player.update(TICK_DURATION);
+    spawnProjectiles();
+
+    m_entityManager.updateAll(TICK_DURATION);
+
+    // The camera scrolls at the run speed, the player moves freely inside it
+    m_previousCameraCenter = m_cameraCenter;
+    m_cameraCenter.x += m_player.getRunSpeed() * TICK_DURATION;
+    const sf::FloatRect cameraRect = getCameraRect();
+    m_player.clampTo(cameraRect, m_entityManager);
+    m_entityManager.setActiveArea(cameraRect);
+
+    m_entityManager.updateColisions();
+    m_entityManager.destroyEntitiesLeftOf(cameraRect.position.x - m_logicalResolution.x);
+
+    ++m_tickCount;
+}
+
+bool Simulation::advance(const InputState& input)
+{
+    tick(input);
+    if (!isOver())
+        return false;
+
+    // The restart wipes the state: keep a trace of how this run ended
+    m_endedRunsHash = computeStateHash();
+    reset();
+    return true;
+}
+
+bool Simulation::isOver() const
+{
+    return !m_entityManager.isAlive(m_player.getHandle());
+}
+
+std::uint64_t Simulation::computeStateHash() const
+{
+    StateHash hash;
+    hash.add(m_endedRunsHash);
+    hash.add(m_tickCount);
+    hash.add(m_cameraCenter);
+    hash.add(m_player.getRunSpeed());
+    m_entityManager.hashState(hash);
+    return hash.getValue();
+}
+
+sf::FloatRect Simulation::getCameraRect() const
+{
+    return { m_cameraCenter - m_logicalResolution / 2.f, m_logicalResolution };
+}
+
+void Simulation::startRun()
+{
+    m_entityManager.clear();
+    m_rng.seed(m_seed);
+    m_tickCount = 0;
+
+    m_cameraCenter = m_logicalResolution / 2.f;
+    m_previousCameraCenter = m_cameraCenter;
+    m_entityManager.setActiveArea(getCameraRect());
+
+    m_player.spawn(m_entityManager, { m_logicalResolution.x * 0.2f, m_logicalResolution.y / 2.f });
+}
+
+void Simulation::spawnProjectiles()
+{
+    if (m_tickCount % PROJECTILE_INTERVAL != 0)
+        return;
+
+    const sf::FloatRect cameraRect = getCameraRect();
+    const float y = static_cast<float>(m_rng() % static_cast<std::uint32_t>(m_logicalResolution.y - 16.f));
+    m_entityManager.spawnEntity(entityUIDOf(EntityType::Projectile), { cameraRect.position.x + cameraRect.size.x + 64.f, y });
+}
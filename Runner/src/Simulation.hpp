@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include "EntityManager.hpp"
+#include "InputState.hpp"
+#include "LevelManager.hpp"
+#include "Player.hpp"
+
+// Everything that advances with the fixed tick: entities, level streaming, player,
+// camera scrolling and spawning. It owns no window and no texture, so it runs the same way inside
+// Game::run() and in headless mode.
+// Given the same seed and the same inputs, every tick produces the same state.
+class Simulation
+{
+public:
+    static constexpr int TICK_RATE = 60;
+    static constexpr float TICK_DURATION = 1.f / TICK_RATE;
+
+    Simulation(sf::Vector2u logicalResolution, std::uint32_t seed);
+
+    // Throws if the level file cannot be opened
+    void loadLevel(int levelUID, bool isInfinite);
+    // Spreads the entity update and the broad phase over jobSystem (see EntityManager::setJobSystem())
+    void setJobSystem(JobSystem* jobSystem) { m_entityManager.setJobSystem(jobSystem); }
+    // Starts a new run from the initial state (after a death for example)
+    void reset();
+    void tick(const InputState& input);
+    // tick(), then starts a new run if the player died. Returns true when a run ended.
+    // This is the one input path: the game loop, headless mode and replays all go through it.
+    bool advance(const InputState& input);
+
+    bool isOver() const;
+
+    EntityManager& getEntityManager() { return m_entityManager; }
+    const EntityManager& getEntityManager() const { return m_entityManager; }
+    const Player& getPlayer() const { return m_player; }
+    const LevelManager& getLevelManager() const { return m_levelManager; }
+
+    // Camera centers at the end of the last two ticks, for interpolated rendering
+    sf::Vector2f getCameraCenter() const { return m_cameraCenter; }
+    sf::Vector2f getPreviousCameraCenter() const { return m_previousCameraCenter; }
+    sf::FloatRect getCameraRect() const;
+
+    std::uint64_t getTickCount() const { return m_tickCount; }
+    std::uint32_t getSeed() const { return m_seed; }
+
+    // Fingerprint of the whole state, including how every run ended since loadLevel():
+    // two sessions with the same hash went through the same states
+    std::uint64_t computeStateHash() const;
+
+private:
+    static constexpr std::uint64_t PROJECTILE_INTERVAL = 45;
+
+    void startRun();
+    void spawnProjectiles();
+
+    const sf::Vector2f m_logicalResolution;
+    const std::uint32_t m_seed;
+
+    EntityManager m_entityManager;
+    LevelManager m_levelManager;
+    Player m_player;
+    // Own integer mapping on top of mt19937: std distributions differ between standard libraries
+    std::mt19937 m_rng;
+
+    sf::Vector2f m_cameraCenter;
+    sf::Vector2f m_previousCameraCenter;
+    std::uint64_t m_tickCount = 0;
+    std::uint64_t m_endedRunsHash = 0;
+};
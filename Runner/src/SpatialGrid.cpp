@@ -0,0 +1,187 @@
+#include "SpatialGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Entity.hpp"
+#include "JobSystem.hpp"
+
+SpatialGrid::SpatialGrid(sf::Vector2u logicalResolution)
+{
+    setLogicalResolution(logicalResolution);
+}
+
+void SpatialGrid::setLogicalResolution(sf::Vector2u logicalResolution)
+{
+    m_cellSize = { static_cast<float>(logicalResolution.x) / CELLS_PER_SCREEN_X,
+                   static_cast<float>(logicalResolution.y) / CELLS_PER_SCREEN_Y };
+}
+
+void SpatialGrid::findPairs(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices,
+    std::vector<Pair>& pairs, JobSystem* jobSystem)
+{
+    pairs.clear();
+    if (indices.size() < 2)
+        return;
+
+    rebuild(hitboxes, indices, jobSystem);
+
+    if (!jobSystem || jobSystem->getThreadCount() == 1 || m_rows <= ROWS_PER_BATCH)
+    {
+        findPairsInCells(hitboxes, indices, 0, m_columns * m_rows, pairs);
+    }
+    else
+    {
+        const std::size_t batchCount = (m_rows + ROWS_PER_BATCH - 1) / ROWS_PER_BATCH;
+        if (m_batchPairs.size() < batchCount)
+            m_batchPairs.resize(batchCount);
+
+        jobSystem->parallelFor(batchCount, 1, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t batch = begin; batch < end; ++batch)
+            {
+                const unsigned int firstRow = static_cast<unsigned int>(batch) * ROWS_PER_BATCH;
+                const unsigned int endRow = std::min(firstRow + ROWS_PER_BATCH, m_rows);
+                m_batchPairs[batch].clear();
+                findPairsInCells(hitboxes, indices, firstRow * m_columns, endRow * m_columns, m_batchPairs[batch]);
+            }
+        });
+
+        for (std::size_t batch = 0; batch < batchCount; ++batch)
+            pairs.insert(pairs.end(), m_batchPairs[batch].begin(), m_batchPairs[batch].end());
+    }
+
+    std::sort(pairs.begin(), pairs.end());
+}
+
+void SpatialGrid::findPairsInCells(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices,
+    unsigned int firstCell, unsigned int endCell, std::vector<Pair>& pairs) const
+{
+    for (unsigned int cell = firstCell; cell < endCell; ++cell)
+    {
+        const std::uint32_t begin = m_cellStarts[cell];
+        const std::uint32_t end = m_cellStarts[cell + 1];
+        const unsigned int x = cell % m_columns;
+        const unsigned int y = cell / m_columns;
+
+        for (std::uint32_t a = begin; a < end; ++a)
+        {
+            const std::uint32_t first = m_cellEntries[a];
+            const sf::FloatRect& hitbox = hitboxes[indices[first]];
+            const CellRange& range = m_ranges[first];
+
+            for (std::uint32_t b = a + 1; b < end; ++b)
+            {
+                const std::uint32_t second = m_cellEntries[b];
+                const CellRange& otherRange = m_ranges[second];
+
+                // A pair sharing several cells is only reported by the cell holding the
+                // top-left corner of their overlap, so no deduplication pass is needed
+                if (std::max(range.minX, otherRange.minX) != x || std::max(range.minY, otherRange.minY) != y)
+                    continue;
+
+                if (isColliding(hitbox, hitboxes[indices[second]]))
+                    pairs.emplace_back(indices[first], indices[second]);
+            }
+        }
+    }
+}
+
+void SpatialGrid::rebuild(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices, JobSystem* jobSystem)
+{
+    sf::Vector2f minCorner = hitboxes[indices.front()].position;
+    sf::Vector2f maxCorner = minCorner;
+    for (const std::uint32_t index : indices)
+    {
+        const sf::FloatRect& hitbox = hitboxes[index];
+        minCorner.x = std::min(minCorner.x, hitbox.position.x);
+        minCorner.y = std::min(minCorner.y, hitbox.position.y);
+        maxCorner.x = std::max(maxCorner.x, hitbox.position.x + hitbox.size.x);
+        maxCorner.y = std::max(maxCorner.y, hitbox.position.y + hitbox.size.y);
+    }
+
+    // Only active (on screen) entities get here, so the grid normally spans about one
+    // screen. If something far away slips in, cells grow instead of the grid.
+    m_origin = minCorner;
+    m_currentCellSize = m_cellSize;
+    const sf::Vector2f extent = maxCorner - minCorner;
+    // Clamped while still a float: a far hitbox gives a quotient no unsigned int can hold
+    const float maxCells = static_cast<float>(MAX_CELLS_PER_AXIS);
+    m_columns = static_cast<unsigned int>(std::min(std::ceil(extent.x / m_currentCellSize.x), maxCells)) + 1;
+    m_rows = static_cast<unsigned int>(std::min(std::ceil(extent.y / m_currentCellSize.y), maxCells)) + 1;
+    if (m_columns > MAX_CELLS_PER_AXIS)
+    {
+        m_currentCellSize.x = extent.x / (MAX_CELLS_PER_AXIS - 1);
+        m_columns = MAX_CELLS_PER_AXIS;
+    }
+    if (m_rows > MAX_CELLS_PER_AXIS)
+    {
+        m_currentCellSize.y = extent.y / (MAX_CELLS_PER_AXIS - 1);
+        m_rows = MAX_CELLS_PER_AXIS;
+    }
+
+    const unsigned int cellCount = m_columns * m_rows;
+    m_cellStarts.assign(cellCount + 1, 0);
+    m_ranges.resize(indices.size());
+
+    // Cells covered by each hitbox, independent of each other
+    const auto computeRanges = [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const sf::FloatRect& hitbox = hitboxes[indices[i]];
+            CellRange& range = m_ranges[i];
+            range.minX = cellX(hitbox.position.x);
+            range.minY = cellY(hitbox.position.y);
+            range.maxX = cellX(hitbox.position.x + hitbox.size.x);
+            range.maxY = cellY(hitbox.position.y + hitbox.size.y);
+        }
+    };
+    if (jobSystem)
+        jobSystem->parallelFor(indices.size(), RANGES_PER_BATCH, computeRanges);
+    else
+        computeRanges(0, indices.size());
+
+    // Count pass
+    for (const CellRange& range : m_ranges)
+    {
+        for (unsigned int y = range.minY; y <= range.maxY; ++y)
+            for (unsigned int x = range.minX; x <= range.maxX; ++x)
+                ++m_cellStarts[y * m_columns + x + 1];
+    }
+
+    for (unsigned int cell = 0; cell < cellCount; ++cell)
+        m_cellStarts[cell + 1] += m_cellStarts[cell];
+
+    // Fill pass, in input order so each cell lists its hitboxes by ascending index
+    m_cellEntries.resize(m_cellStarts[cellCount]);
+    for (std::uint32_t i = 0; i < indices.size(); ++i)
+    {
+        const CellRange& range = m_ranges[i];
+        for (unsigned int y = range.minY; y <= range.maxY; ++y)
+        {
+            for (unsigned int x = range.minX; x <= range.maxX; ++x)
+            {
+                // m_cellStarts[cell] is used as the write cursor and ends up at the next cell's start
+                m_cellEntries[m_cellStarts[y * m_columns + x]++] = i;
+            }
+        }
+    }
+
+    // Shift the cursors back to the cell starts
+    for (unsigned int cell = cellCount; cell > 0; --cell)
+        m_cellStarts[cell] = m_cellStarts[cell - 1];
+    m_cellStarts[0] = 0;
+}
+
+unsigned int SpatialGrid::cellX(float x) const
+{
+    const float cell = std::floor((x - m_origin.x) / m_currentCellSize.x);
+    return static_cast<unsigned int>(std::clamp(cell, 0.f, static_cast<float>(m_columns - 1)));
+}
+
+unsigned int SpatialGrid::cellY(float y) const
+{
+    const float cell = std::floor((y - m_origin.y) / m_currentCellSize.y);
+    return static_cast<unsigned int>(std::clamp(cell, 0.f, static_cast<float>(m_rows - 1)));
+}
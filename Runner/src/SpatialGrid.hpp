@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+class JobSystem;
+
+// Broad phase for EntityManager::updateColisions().
+// A uniform grid whose cell size is a fraction of the logical resolution. It is
+// rebuilt from scratch every fixed tick (counting sort into reused buffers, no
+// allocation once warm) and only hands candidate pairs to the narrow FloatRect test.
+// Pairs come out sorted by (first, second) with first < second, which is the same
+// order as the brute-force double loop, so replays stay deterministic.
+// Given a JobSystem, the cells are searched in parallel batches of rows; each batch
+// writes its own pair list and the lists are joined in cell order, so the result
+// does not depend on the thread count.
+class SpatialGrid
+{
+public:
+    using Pair = std::pair<std::uint32_t, std::uint32_t>;
+
+    static constexpr unsigned int CELLS_PER_SCREEN_X = 16;
+    static constexpr unsigned int CELLS_PER_SCREEN_Y = 9;
+    static constexpr unsigned int MAX_CELLS_PER_AXIS = 256;
+    // Parallel search: rows of cells per job, and hitboxes per job when placing them in cells
+    static constexpr unsigned int ROWS_PER_BATCH = 8;
+    static constexpr std::size_t RANGES_PER_BATCH = 8192;
+
+    explicit SpatialGrid(sf::Vector2u logicalResolution = { 1920, 1080 });
+
+    void setLogicalResolution(sf::Vector2u logicalResolution);
+    sf::Vector2f getCellSize() const { return m_cellSize; }
+
+    // hitboxes is indexed by the values of indices (which must be ascending).
+    // Colliding pairs are written to pairs as values taken from indices.
+    // Without a jobSystem, everything runs on the calling thread.
+    void findPairs(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices,
+        std::vector<Pair>& pairs, JobSystem* jobSystem = nullptr);
+
+private:
+    struct CellRange
+    {
+        unsigned int minX, minY, maxX, maxY;
+    };
+
+    void rebuild(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices, JobSystem* jobSystem);
+    // Appends the pairs reported by the cells [firstCell, endCell), unsorted
+    void findPairsInCells(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices,
+        unsigned int firstCell, unsigned int endCell, std::vector<Pair>& pairs) const;
+    unsigned int cellX(float x) const;
+    unsigned int cellY(float y) const;
+
+    sf::Vector2f m_cellSize;
+
+    // Grid of the current tick
+    sf::Vector2f m_origin;
+    sf::Vector2f m_currentCellSize;
+    unsigned int m_columns = 0;
+    unsigned int m_rows = 0;
+
+    // Compressed cell storage: m_cellEntries[m_cellStarts[c] .. m_cellStarts[c + 1]]
+    // holds the positions (in indices) of the hitboxes touching cell c
+    std::vector<std::uint32_t> m_cellStarts;
+    std::vector<std::uint32_t> m_cellEntries;
+    std::vector<CellRange> m_ranges;
+
+    // One pair list per parallel batch, kept between ticks for their capacity
+    std::vector<std::vector<Pair>> m_batchPairs;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+// 64-bit FNV-1a over raw bytes, used to fingerprint the simulation state.
+// Floats are hashed bit for bit: two states only hash the same if they are identical.
+class StateHash
+{
+public:
+    void add(const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            m_value ^= bytes[i];
+            m_value *= PRIME;
+        }
+    }
+
+    template <typename T>
+    void add(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be hashed as bytes");
+        add(&value, sizeof(T));
+    }
+
+    template <typename T>
+    void add(std::span<const T> values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values can be hashed as bytes");
+        add(values.data(), values.size_bytes());
+    }
+
+    std::uint64_t getValue() const { return m_value; }
+
+private:
+    static constexpr std::uint64_t OFFSET_BASIS = 14695981039346656037ull;
+    static constexpr std::uint64_t PRIME = 1099511628211ull;
+
+    std::uint64_t m_value = OFFSET_BASIS;
+};
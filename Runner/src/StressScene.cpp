@@ -0,0 +1,20 @@
+#include "StressScene.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+#include "EntityManager.hpp"
+
+void spawnStressScene(EntityManager& entityManager, std::uint32_t seed, int entityCount, float spacing)
+{
+    std::mt19937 rng(seed);
+    const std::uint32_t side = std::max(1u, static_cast<std::uint32_t>(std::sqrt(static_cast<float>(entityCount)) * spacing));
+
+    entityManager.reserve(static_cast<std::size_t>(entityCount));
+    for (int i = 0; i < entityCount; ++i)
+    {
+        const int entityUID = i % 500 == 0 ? entityUIDOf(EntityType::Player) : 1 + static_cast<int>(rng() % 4);
+        entityManager.spawnEntity(entityUID, { static_cast<float>(rng() % side), static_cast<float>(rng() % side) });
+    }
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstdint>
+
+class EntityManager;
+
+// Dense crowd of entityCount random entities for benchmarks and tests, spread over a
+// square whose side grows with the count: neighbours stay about spacing apart, so the
+// collision load per entity does not depend on the count.
+// One entity in 500 is a player (they die on the way, which removes entities in pair
+// order), the others are random obstacles. Same seed, same scene.
+void spawnStressScene(EntityManager& entityManager, std::uint32_t seed, int entityCount, float spacing);
@@ -0,0 +1,110 @@
+#include "TextLevelSource.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    // Next whitespace separated token of line (empty at the end or on a comment)
+    std::string_view nextToken(std::string_view& line)
+    {
+        const std::size_t begin = line.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos || line[begin] == '#')
+        {
+            line = {};
+            return {};
+        }
+        const std::size_t end = std::min(line.find_first_of(" \t\r", begin), line.size());
+        const std::string_view token = line.substr(begin, end - begin);
+        line.remove_prefix(end);
+        return token;
+    }
+
+    template <typename T>
+    std::optional<T> parseNumber(std::string_view token)
+    {
+        T value{};
+        const auto [end, error] = std::from_chars(token.data(), token.data() + token.size(), value);
+        if (token.empty() || error != std::errc() || end != token.data() + token.size())
+            return std::nullopt;
+        return value;
+    }
+
+    template <typename T>
+    T expectNumber(std::string_view token, const std::filesystem::path& filePath, const std::string& where)
+    {
+        const std::optional<T> value = parseNumber<T>(token);
+        if (!value)
+            throw std::runtime_error(filePath.string() + ", " + where + ": expected a number, got '" + std::string(token) + "'");
+        return *value;
+    }
+}
+
+TextLevelSource::TextLevelSource(const std::filesystem::path& filePath, std::pmr::memory_resource* memory)
+    : m_filePath(filePath), m_chunkOffsets(memory)
+{
+    // Binary mode: offsets from tellg() must be valid for seekg() whatever the line endings
+    m_file.open(filePath, std::ios::binary);
+    if (!m_file)
+        throw std::runtime_error("TextLevelSource: cannot open " + filePath.string());
+
+    int lineNumber = 0;
+    while (std::getline(m_file, m_line))
+    {
+        ++lineNumber;
+        const std::string where = "line " + std::to_string(lineNumber);
+        std::string_view rest = m_line;
+        const std::string_view keyword = nextToken(rest);
+
+        if (keyword == "level")
+        {
+            m_levelUID = expectNumber<int>(nextToken(rest), filePath, where);
+        }
+        else if (keyword == "chunkWidth")
+        {
+            m_chunkWidth = expectNumber<float>(nextToken(rest), filePath, where);
+        }
+        else if (keyword == "chunk")
+        {
+            const int chunkIndex = expectNumber<int>(nextToken(rest), filePath, where);
+            if (chunkIndex != getChunkCount())
+            {
+                throw std::runtime_error(filePath.string() + ", " + where + ": chunks must be numbered 0, 1, 2...");
+            }
+            m_chunkOffsets.push_back(static_cast<std::streamoff>(m_file.tellg()));
+        }
+    }
+
+    if (m_levelUID < 0 || m_chunkWidth <= 0.f)
+        throw std::runtime_error("TextLevelSource: " + filePath.string() + " needs 'level' and 'chunkWidth' before its chunks");
+}
+
+void TextLevelSource::readChunk(int chunkIndex, std::vector<LevelEntityRecord>& entities)
+{
+    entities.clear();
+
+    m_file.clear();
+    m_file.seekg(m_chunkOffsets.at(static_cast<std::size_t>(chunkIndex)));
+
+    while (std::getline(m_file, m_line))
+    {
+        std::string_view rest = m_line;
+        const std::string_view first = nextToken(rest);
+        if (first.empty())
+            continue;
+        if (first == "chunk")
+            break;
+
+        const std::optional<std::int32_t> entityUID = parseNumber<std::int32_t>(first);
+        const std::optional<float> x = parseNumber<float>(nextToken(rest));
+        const std::optional<float> y = parseNumber<float>(nextToken(rest));
+        if (!entityUID || !x || !y)
+            throw std::runtime_error(m_filePath.string() + ", chunk " + std::to_string(chunkIndex) + ": bad entity line '" + m_line + "'");
+
+        entities.push_back({ *entityUID, *x, *y });
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "LevelData.hpp"
+
+// Reads the text level format:
+//
+//     # comment
+//     level 1
+//     chunkWidth 1920
+//     chunk 0
+//     <entityUID> <x> <y>
+//     ...
+//     chunk 1
+//     ...
+//
+// Opening only indexes where each chunk starts; entities are parsed chunk by chunk.
+class TextLevelSource : public LevelChunkSource
+{
+public:
+    // The chunk index is allocated from memory (the level's arena when loaded by the LevelManager)
+    explicit TextLevelSource(const std::filesystem::path& filePath, std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+    int getLevelUID() const override { return m_levelUID; }
+    float getChunkWidth() const override { return m_chunkWidth; }
+    int getChunkCount() const override { return static_cast<int>(m_chunkOffsets.size()); }
+
+    void readChunk(int chunkIndex, std::vector<LevelEntityRecord>& entities) override;
+
+private:
+    std::filesystem::path m_filePath;
+    std::ifstream m_file;
+    std::string m_line; // reused, reading a chunk does not allocate once warm
+    int m_levelUID = -1;
+    float m_chunkWidth = 0.f;
+    std::pmr::vector<std::streamoff> m_chunkOffsets; // first line after "chunk <index>"
+};
@@ -0,0 +1,52 @@
+#include "TextureAtlas.hpp"
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include "AtlasPacker.hpp"
+
+namespace
+{
+    constexpr std::array<const char*, ENTITY_TYPE_COUNT> IMAGE_NAMES = {
+        "player.png", "spike.png", "moving_enemy.png", "projectile.png", "collectible.png"
+    };
+
+    constexpr std::array<sf::Color, ENTITY_TYPE_COUNT> FALLBACK_COLORS = {
+        sf::Color::Green, sf::Color::White, sf::Color::Magenta, sf::Color::Red, sf::Color::Yellow
+    };
+
+    constexpr unsigned int FALLBACK_SIZE = 16;
+}
+
+void TextureAtlas::loadFromDirectory(const std::filesystem::path& directory)
+{
+    std::vector<sf::Image> images(ENTITY_TYPE_COUNT);
+    std::vector<sf::Vector2u> imageSizes(ENTITY_TYPE_COUNT);
+    for (std::size_t type = 0; type < ENTITY_TYPE_COUNT; ++type)
+    {
+        const std::filesystem::path path = directory / IMAGE_NAMES[type];
+        if (!std::filesystem::exists(path) || !images[type].loadFromFile(path))
+        {
+            std::cerr << "TextureAtlas: " << path.string() << " not found, using a placeholder" << std::endl;
+            images[type].resize({ FALLBACK_SIZE, FALLBACK_SIZE }, FALLBACK_COLORS[type]);
+        }
+        imageSizes[type] = images[type].getSize();
+    }
+
+    const AtlasLayout layout = packAtlas(imageSizes);
+
+    sf::Image atlas(layout.size, sf::Color::Transparent);
+    for (std::size_t type = 0; type < ENTITY_TYPE_COUNT; ++type)
+    {
+        const sf::IntRect& region = layout.regions[type];
+        if (!atlas.copy(images[type], static_cast<sf::Vector2u>(region.position)))
+            throw std::runtime_error("TextureAtlas: failed to copy " + std::string(IMAGE_NAMES[type]));
+        m_textureRects[type] = static_cast<sf::FloatRect>(region);
+    }
+
+    if (!m_texture.loadFromImage(atlas))
+        throw std::runtime_error("TextureAtlas: failed to create the atlas texture");
+}
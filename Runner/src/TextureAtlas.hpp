@@ -0,0 +1,26 @@
+#pragma once
+
+#include <array>
+#include <filesystem>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include "Entity.hpp"
+
+// Every entity, obstacle and collectible image packed into a single texture at load
+// time, so the whole stage can be drawn without switching textures.
+class TextureAtlas
+{
+public:
+    // Loads <directory>/<type>.png for every entity type (player.png, spike.png...).
+    // A missing image is replaced by a flat colored square so the game still runs.
+    void loadFromDirectory(const std::filesystem::path& directory);
+
+    const sf::Texture& getTexture() const { return m_texture; }
+    const std::array<sf::FloatRect, ENTITY_TYPE_COUNT>& getTextureRects() const { return m_textureRects; }
+
+private:
+    sf::Texture m_texture;
+    std::array<sf::FloatRect, ENTITY_TYPE_COUNT> m_textureRects;
+};
@@ -1,21 +1,122 @@
-#include <SFML/Graphics.hpp>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iostream>
+#include <string>
 
-int main()
+#include "BinaryLevelFormat.hpp"
+#include "Game.hpp"
+
+namespace
 {
-    sf::RenderWindow window(sf::VideoMode({ 200, 200 }), "SFML works!");
-    sf::CircleShape shape(100.f);
-    shape.setFillColor(sf::Color::Green);
+    // Text to binary level converter, no window involved
+    int runLevelCompiler(const std::filesystem::path& textFilePath, std::filesystem::path binaryFilePath)
+    {
+        if (binaryFilePath.empty())
+            binaryFilePath = std::filesystem::path(textFilePath).replace_extension(".rlvl");
+
+        try
+        {
+            compileLevel(textFilePath, binaryFilePath);
+        }
+        catch (const std::exception& exception)
+        {
+            std::cerr << "Cannot compile " << textFilePath.string() << ": " << exception.what() << std::endl;
+            return 1;
+        }
+        std::cout << textFilePath.string() << " -> " << binaryFilePath.string() << std::endl;
+        return 0;
+    }
+}
+
+// Usage: Runner [--level <levelUID>] [--infinite] [--headless [tickCount]] [--record <run.rrec>] [--trace <trace.json>]
+//        Runner --replay <run.rrec>
+//        Runner --compile-level <level.txt> [level.rlvl]
+int main(int argc, char* argv[])
+{
+    if (argc >= 3 && std::string(argv[1]) == "--compile-level")
+        return runLevelCompiler(argv[2], argc >= 4 ? argv[3] : "");
+
+    if (argc >= 3 && std::string(argv[1]) == "--replay")
+    {
+        Game game;
+        try
+        {
+            return game.runReplay(argv[2]) ? 0 : 1;
+        }
+        catch (const std::exception& exception)
+        {
+            std::cerr << "Cannot replay " << argv[2] << ": " << exception.what() << std::endl;
+            return 1;
+        }
+    }
+
+    int levelUID = 1;
+    bool isInfinite = false;
+    bool isHeadless = false;
+    std::uint64_t tickCount = 60 * 60 * 10;
+    std::filesystem::path recordingPath;
+    std::filesystem::path tracePath;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string argument = argv[i];
+        if (argument == "--level" && i + 1 < argc)
+        {
+            levelUID = std::atoi(argv[++i]);
+        }
+        else if (argument == "--infinite")
+        {
+            isInfinite = true;
+        }
+        else if (argument == "--headless")
+        {
+            isHeadless = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                tickCount = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (argument == "--record" && i + 1 < argc)
+        {
+            recordingPath = argv[++i];
+        }
+        else if (argument == "--trace" && i + 1 < argc)
+        {
+            tracePath = argv[++i];
+        }
+    }
 
-    while (window.isOpen())
+    Game game;
+    try
     {
-        while (const std::optional event = window.pollEvent())
+        game.loadLevel(levelUID, isInfinite);
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << "Level " << levelUID << " not loaded: " << exception.what() << std::endl;
+    }
+
+    if (!tracePath.empty())
+    {
+        try
+        {
+            game.traceTo(tracePath);
+        }
+        catch (const std::exception& exception)
         {
-            if (event->is<sf::Event::Closed>())
-                window.close();
+            std::cerr << exception.what() << std::endl;
         }
+    }
 
-        window.clear();
-        window.draw(shape);
-        window.display();
+    if (isHeadless)
+    {
+        game.runHeadless(tickCount);
+    }
+    else
+    {
+        if (!recordingPath.empty())
+            game.recordTo(recordingPath);
+        game.run();
     }
-}
\ No newline at end of file
+    return 0;
+}
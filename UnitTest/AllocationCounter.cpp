@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "AllocationCounter.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+	thread_local std::uint64_t threadAllocationCount = 0;
+
+	void* allocate(std::size_t size)
+	{
+		++threadAllocationCount;
+		if (void* memory = std::malloc(size == 0 ? 1 : size))
+			return memory;
+		throw std::bad_alloc();
+	}
+
+	void* allocateAligned(std::size_t size, std::align_val_t alignment)
+	{
+		++threadAllocationCount;
+		const std::size_t alignmentValue = static_cast<std::size_t>(alignment);
+#ifdef _WIN32
+		void* memory = _aligned_malloc(size == 0 ? 1 : size, alignmentValue);
+#else
+		void* memory = std::aligned_alloc(alignmentValue, (size + alignmentValue - 1) / alignmentValue * alignmentValue);
+#endif
+		if (!memory)
+			throw std::bad_alloc();
+		return memory;
+	}
+
+	void freeAligned(void* memory)
+	{
+#ifdef _WIN32
+		_aligned_free(memory);
+#else
+		std::free(memory);
+#endif
+	}
+}
+
+std::uint64_t AllocationCounter::getThreadAllocationCount()
+{
+	return threadAllocationCount;
+}
+
+// The array and nothrow forms of the standard library forward to these ones
+void* operator new(std::size_t size)
+{
+	return allocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+	return allocateAligned(size, alignment);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept
+{
+	freeAligned(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept
+{
+	freeAligned(memory);
+}
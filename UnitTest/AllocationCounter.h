@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstdint>
+
+// The UnitTest project replaces the global operator new (see AllocationCounter.cpp)
+// to count heap allocations. Counts are per thread, so the level streamer's loader
+// thread or the test framework do not disturb a measurement.
+namespace AllocationCounter
+{
+	// Heap allocations made by the calling thread since it started
+	std::uint64_t getThreadAllocationCount();
+
+	// Counts the allocations made on this thread while the scope is alive
+	class Scope
+	{
+	public:
+		Scope() : m_start(getThreadAllocationCount()) {}
+
+		std::uint64_t getAllocationCount() const { return getThreadAllocationCount() - m_start; }
+
+	private:
+		std::uint64_t m_start;
+	};
+}
@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "AllocationCounter.h"
+#include "EntityManager.hpp"
+#include "LevelArena.hpp"
+#include "Simulation.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	struct DestructionCounter
+	{
+		explicit DestructionCounter(int& destroyedCount) : destroyedCount(destroyedCount) {}
+		~DestructionCounter() { ++destroyedCount; }
+
+		int& destroyedCount;
+	};
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(AllocationTests)
+	{
+	public:
+
+		TEST_METHOD(CounterSeesHeapAllocations)
+		{
+			const AllocationCounter::Scope allocations;
+			const std::unique_ptr<int> number = std::make_unique<int>(1);
+			const std::vector<int> numbers(100);
+			Assert::AreEqual(static_cast<std::uint64_t>(2), allocations.getAllocationCount());
+		}
+
+		TEST_METHOD(LevelArenaResetDestroysEverythingAtOnce)
+		{
+			LevelArena arena(1024);
+			int destroyedCount = 0;
+			for (int i = 0; i < 100; ++i)
+				arena.create<DestructionCounter>(destroyedCount);
+			std::pmr::vector<int> numbers(&arena);
+			numbers.assign(2000, 7); // bigger than a block
+			Assert::IsTrue(arena.getBytesUsed() >= 2000 * sizeof(int));
+
+			const std::size_t capacity = arena.getCapacity();
+			arena.reset();
+			Assert::AreEqual(100, destroyedCount);
+			Assert::AreEqual(static_cast<std::size_t>(0), arena.getBytesUsed());
+
+			// The next level reuses the blocks
+			const AllocationCounter::Scope allocations;
+			for (int i = 0; i < 100; ++i)
+				arena.create<DestructionCounter>(destroyedCount);
+			Assert::AreEqual(static_cast<std::uint64_t>(0), allocations.getAllocationCount());
+			Assert::AreEqual(capacity, arena.getCapacity());
+
+			arena.release();
+			Assert::AreEqual(200, destroyedCount);
+			Assert::AreEqual(static_cast<std::size_t>(0), arena.getCapacity());
+		}
+
+		TEST_METHOD(SteadyStateUpdateAllDoesNotAllocate)
+		{
+			std::mt19937 rng(7);
+			EntityManager entityManager;
+			entityManager.setLogicalResolution({ 1920, 1080 });
+			for (int i = 0; i < 5000; ++i)
+			{
+				const int entityUID = entityUIDOf(i % 2 == 0 ? EntityType::MovingEnemy : EntityType::Spike);
+				entityManager.spawnEntity(entityUID, { static_cast<float>(rng() % 20000), static_cast<float>(rng() % 1080) });
+			}
+			entityManager.setActiveArea({ { 0.f, 0.f }, { 20000.f, 1080.f } });
+
+			// Warm up: the scratch buffers grow to their steady-state size
+			for (int tick = 0; tick < 10; ++tick)
+			{
+				entityManager.updateAll(Simulation::TICK_DURATION);
+				entityManager.updateColisions();
+			}
+
+			const AllocationCounter::Scope allocations;
+			for (int tick = 0; tick < 120; ++tick)
+			{
+				entityManager.updateAll(Simulation::TICK_DURATION);
+				entityManager.updateColisions();
+			}
+			const std::uint64_t allocationCount = allocations.getAllocationCount(); // before the message allocates
+			Logger::WriteMessage(("Allocations in 120 steady-state ticks: " + std::to_string(allocationCount) + "\n").c_str());
+			Assert::AreEqual(static_cast<std::uint64_t>(0), allocationCount);
+		}
+
+		TEST_METHOD(SteadyStateSimulationTickDoesNotAllocate)
+		{
+			Simulation simulation({ 1920, 1080 }, 42);
+			InputState input;
+
+			// Runs end and restart often without inputs: warm-up covers deaths and restarts too
+			auto run = [&](int tickCount)
+			{
+				for (int tick = 0; tick < tickCount; ++tick)
+				{
+					input.setPressed(InputAction::Up, tick % 90 < 30);
+					simulation.tick(input);
+					if (simulation.isOver())
+						simulation.reset();
+				}
+			};
+			run(60 * 60);
+
+			const AllocationCounter::Scope allocations;
+			run(60 * 60);
+			Assert::AreEqual(static_cast<std::uint64_t>(0), allocations.getAllocationCount());
+		}
+	};
+}
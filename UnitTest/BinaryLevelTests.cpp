@@ -0,0 +1,215 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinaryLevelSource.hpp"
+#include "EntityManager.hpp"
+#include "LevelManager.hpp"
+#include "LevelStreamer.hpp"
+#include "TextLevelSource.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	constexpr float ROUND_TRIP_CHUNK_WIDTH = 1920.f;
+
+	// Shortest representation that reads back to the same float
+	std::string floatToString(float value)
+	{
+		char buffer[32];
+		const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+		return std::string(buffer, end);
+	}
+
+	// Static entity kinds only, so spawned positions do not depend on time
+	std::filesystem::path writeRandomTextLevel(const std::string& name, int chunkCount, int maxEntitiesPerChunk)
+	{
+		std::mt19937 rng(1234);
+		const int entityUIDs[] = { entityUIDOf(EntityType::Spike), entityUIDOf(EntityType::Collectible) };
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+		std::ofstream file(path, std::ios::trunc);
+		file << "level 3\nchunkWidth " << ROUND_TRIP_CHUNK_WIDTH << "\n";
+		for (int chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			file << "chunk " << chunk << "\n";
+			const int entityCount = static_cast<int>(rng() % static_cast<unsigned>(maxEntitiesPerChunk + 1)); // empty chunks too
+			for (int i = 0; i < entityCount; ++i)
+			{
+				const float x = static_cast<float>(rng() % 1920000) / 1000.f;
+				const float y = static_cast<float>(rng() % 1080000) / 1000.f;
+				file << entityUIDs[rng() % 2] << " " << floatToString(x) << " " << floatToString(y) << "\n";
+			}
+		}
+		return path;
+	}
+
+	std::filesystem::path compileToTemp(const std::filesystem::path& textPath)
+	{
+		const std::filesystem::path binaryPath = std::filesystem::path(textPath).replace_extension(".rlvl");
+		compileLevel(textPath, binaryPath);
+		return binaryPath;
+	}
+
+	void writeBytes(const std::filesystem::path& path, const std::vector<char>& bytes)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	std::vector<char> readBytes(const std::filesystem::path& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		return { std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	}
+
+	bool throwsOnOpen(const std::filesystem::path& path)
+	{
+		try
+		{
+			BinaryLevelSource source(path);
+		}
+		catch (const std::runtime_error&)
+		{
+			return true;
+		}
+		return false;
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(BinaryLevelTests)
+	{
+	public:
+
+		TEST_METHOD(BinaryLevelHasTheTextLevelChunks)
+		{
+			const std::filesystem::path textPath = writeRandomTextLevel("runner_round_trip.txt", 20, 50);
+			const std::filesystem::path binaryPath = compileToTemp(textPath);
+
+			TextLevelSource textSource(textPath);
+			BinaryLevelSource binarySource(binaryPath);
+
+			Assert::AreEqual(textSource.getLevelUID(), binarySource.getLevelUID());
+			Assert::AreEqual(textSource.getChunkWidth(), binarySource.getChunkWidth());
+			Assert::AreEqual(textSource.getChunkCount(), binarySource.getChunkCount());
+
+			std::vector<LevelEntityRecord> textEntities;
+			std::vector<LevelEntityRecord> binaryEntities;
+			for (int i = 0; i < textSource.getChunkCount(); ++i)
+			{
+				textSource.readChunk(i, textEntities);
+				binarySource.readChunk(i, binaryEntities);
+				const std::span<const LevelEntityRecord> view = binarySource.viewChunk(i);
+
+				Assert::IsTrue(textEntities == binaryEntities);
+				Assert::IsTrue(std::equal(view.begin(), view.end(), textEntities.begin(), textEntities.end()));
+			}
+		}
+
+		TEST_METHOD(BothLoadersSpawnIdenticalEntities)
+		{
+			const std::filesystem::path textPath = writeRandomTextLevel("runner_spawn_round_trip.txt", 8, 40);
+			const std::filesystem::path binaryPath = compileToTemp(textPath);
+
+			TextLevelSource textSource(textPath);
+			BinaryLevelSource binarySource(binaryPath);
+			EntityManager textEntities;
+			EntityManager binaryEntities;
+			LevelStreamer textStreamer;
+			LevelStreamer binaryStreamer;
+			textStreamer.start(textSource, true);
+			binaryStreamer.start(binarySource, true);
+
+			// Twice through the level, to cover the infinite loop back to chunk 0
+			for (float cameraLeft = 0.f; cameraLeft < 2 * 8 * ROUND_TRIP_CHUNK_WIDTH; cameraLeft += 500.f)
+			{
+				const sf::FloatRect camera = { { cameraLeft, 0.f }, { 1920.f, 1080.f } };
+				textStreamer.update(camera, textEntities);
+				binaryStreamer.update(camera, binaryEntities);
+
+				Assert::AreEqual(textEntities.getEntityCount(), binaryEntities.getEntityCount());
+				Assert::IsTrue(textEntities.getPositions() == binaryEntities.getPositions());
+				Assert::IsTrue(textEntities.getTypes() == binaryEntities.getTypes());
+			}
+		}
+
+		TEST_METHOD(StaleBinaryLevelIsNotLoaded)
+		{
+			const std::filesystem::path textPath = writeRandomTextLevel("runner_stale.txt", 4, 10);
+			const std::filesystem::path binaryPath = std::filesystem::path(textPath).replace_extension(".rlvl");
+			std::filesystem::remove(binaryPath);
+			Assert::IsTrue(LevelManager::chooseLevelFile(textPath, binaryPath) == textPath);
+
+			compileLevel(textPath, binaryPath);
+			const std::filesystem::file_time_type compileTime = std::filesystem::last_write_time(binaryPath);
+			std::filesystem::last_write_time(textPath, compileTime - std::chrono::seconds(10));
+			Assert::IsTrue(LevelManager::chooseLevelFile(textPath, binaryPath) == binaryPath);
+
+			// The text level was edited after the compilation
+			std::filesystem::last_write_time(textPath, compileTime + std::chrono::seconds(10));
+			Assert::IsTrue(LevelManager::chooseLevelFile(textPath, binaryPath) == textPath);
+		}
+
+		TEST_METHOD(InvalidBinaryLevelThrows)
+		{
+			const std::filesystem::path binaryPath = compileToTemp(writeRandomTextLevel("runner_invalid_binary.txt", 4, 10));
+			const std::vector<char> bytes = readBytes(binaryPath);
+			const std::filesystem::path corruptedPath = std::filesystem::temp_directory_path() / "runner_corrupted.rlvl";
+
+			std::vector<char> badMagic = bytes;
+			badMagic[0] = 'X';
+			writeBytes(corruptedPath, badMagic);
+			Assert::IsTrue(throwsOnOpen(corruptedPath));
+
+			std::vector<char> badVersion = bytes;
+			badVersion[offsetof(BinaryLevelHeader, version)] = static_cast<char>(BINARY_LEVEL_VERSION + 1);
+			writeBytes(corruptedPath, badVersion);
+			Assert::IsTrue(throwsOnOpen(corruptedPath));
+
+			const std::vector<char> truncated(bytes.begin(), bytes.end() - 1);
+			writeBytes(corruptedPath, truncated);
+			Assert::IsTrue(throwsOnOpen(corruptedPath));
+
+			writeBytes(corruptedPath, bytes);
+			Assert::IsFalse(throwsOnOpen(corruptedPath));
+		}
+
+		TEST_METHOD(BinaryLevelOpensFasterThanTextLevel)
+		{
+			const std::filesystem::path textPath = writeRandomTextLevel("runner_large_level.txt", 400, 500);
+			const std::filesystem::path binaryPath = compileToTemp(textPath);
+
+			// Opening then streaming the first screen, as a retry after "Lose" does
+			auto timeLoad = [](auto openSource)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				auto source = openSource();
+				EntityManager entityManager;
+				LevelStreamer streamer;
+				streamer.start(*source, false);
+				streamer.update({ { 0.f, 0.f }, { 1920.f, 1080.f } }, entityManager);
+				return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+			};
+
+			const double textTime = timeLoad([&] { return std::make_unique<TextLevelSource>(textPath); });
+			const double binaryTime = timeLoad([&] { return std::make_unique<BinaryLevelSource>(binaryPath); });
+
+			Logger::WriteMessage(("Text level load: " + std::to_string(textTime) + " ms, binary level load: "
+				+ std::to_string(binaryTime) + " ms\n").c_str());
+			Assert::IsTrue(binaryTime < textTime);
+		}
+	};
+}
@@ -0,0 +1,187 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EntityManager.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	// Baseline the EntityManager replaced: one heap object and one virtual call per entity
+	class BaselineEntity
+	{
+	public:
+		BaselineEntity(sf::Vector2f position, sf::Vector2f velocity)
+			: m_position(position), m_velocity(velocity), m_hitbox(position, { 32.f, 16.f })
+		{
+		}
+		virtual ~BaselineEntity() = default;
+
+		virtual void update(float deltaTime)
+		{
+			m_position += m_velocity * deltaTime;
+			m_hitbox.position = m_position;
+			m_isActive = m_activeArea.position.x < m_hitbox.position.x + m_hitbox.size.x
+				&& m_hitbox.position.x < m_activeArea.position.x + m_activeArea.size.x
+				&& m_activeArea.position.y < m_hitbox.position.y + m_hitbox.size.y
+				&& m_hitbox.position.y < m_activeArea.position.y + m_activeArea.size.y;
+		}
+
+		sf::Vector2f getPosition() const { return m_position; }
+
+	private:
+		int m_health = 1;
+		sf::Vector2f m_position;
+		sf::Vector2f m_velocity;
+		float m_size = 32.f;
+		sf::FloatRect m_hitbox;
+		EntityState m_state = EntityState::Alive;
+		bool m_isActive = true;
+		sf::FloatRect m_activeArea{ { -1.0e30f, -1.0e30f }, { 2.0e30f, 2.0e30f } };
+	};
+
+	class BaselineProjectile : public BaselineEntity
+	{
+	public:
+		using BaselineEntity::BaselineEntity;
+		void update(float deltaTime) override { BaselineEntity::update(deltaTime); }
+	};
+
+	sf::Vector2f benchmarkPosition(int i)
+	{
+		return { static_cast<float>(i % 1000) * 4.f, static_cast<float>(i / 1000) * 4.f };
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(EntityManagerTests)
+	{
+	public:
+
+		TEST_METHOD(SpawnedEntityIsReachableThroughItsHandle)
+		{
+			EntityManager entityManager;
+			const EntityHandle handle = entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 10.f, 20.f });
+
+			Assert::IsTrue(entityManager.isAlive(handle));
+			Assert::AreEqual(10.f, entityManager.getPosition(handle).x);
+			Assert::AreEqual(20.f, entityManager.getPosition(handle).y);
+			Assert::IsTrue(entityManager.getType(handle) == EntityType::Spike);
+		}
+
+		TEST_METHOD(DestroyedHandleIsStaleEvenWhenSlotIsReused)
+		{
+			EntityManager entityManager;
+			const EntityHandle first = entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 0.f, 0.f });
+			entityManager.destroyEntity(first);
+			const EntityHandle second = entityManager.spawnEntity(entityUIDOf(EntityType::Collectible), { 5.f, 5.f });
+
+			Assert::AreEqual(first.index, second.index);
+			Assert::IsFalse(entityManager.isAlive(first));
+			Assert::IsTrue(entityManager.isAlive(second));
+		}
+
+		TEST_METHOD(SwapAndPopKeepsOtherHandlesValid)
+		{
+			EntityManager entityManager;
+			const EntityHandle a = entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 1.f, 0.f });
+			const EntityHandle b = entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 2.f, 0.f });
+			const EntityHandle c = entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 3.f, 0.f });
+
+			entityManager.destroyEntity(a);
+
+			Assert::AreEqual(static_cast<std::size_t>(2), entityManager.getEntityCount());
+			Assert::AreEqual(2.f, entityManager.getPosition(b).x);
+			Assert::AreEqual(3.f, entityManager.getPosition(c).x);
+		}
+
+		TEST_METHOD(UpdateAllIntegratesVelocity)
+		{
+			EntityManager entityManager;
+			const EntityHandle projectile = entityManager.spawnEntity(entityUIDOf(EntityType::Projectile), { 1000.f, 0.f });
+			const sf::Vector2f velocity = entityManager.getVelocity(projectile);
+
+			entityManager.updateAll(0.5f);
+
+			Assert::AreEqual(1000.f + velocity.x * 0.5f, entityManager.getPosition(projectile).x);
+			Assert::AreEqual(entityManager.getPosition(projectile).x, entityManager.getHitbox(projectile).position.x);
+		}
+
+		TEST_METHOD(CollisionsResolveThroughHandles)
+		{
+			EntityManager entityManager;
+			const EntityHandle player = entityManager.spawnEntity(entityUIDOf(EntityType::Player), { 0.f, 0.f });
+			const EntityHandle coin = entityManager.spawnEntity(entityUIDOf(EntityType::Collectible), { 10.f, 10.f });
+			const EntityHandle projectile = entityManager.spawnEntity(entityUIDOf(EntityType::Projectile), { 20.f, 20.f });
+			const EntityHandle farSpike = entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 500.f, 500.f });
+
+			entityManager.updateColisions();
+
+			Assert::IsTrue(entityManager.isAlive(player));
+			Assert::AreEqual(2, entityManager.getHealth(player));
+			Assert::AreEqual(1, entityManager.getScore());
+			Assert::IsFalse(entityManager.isAlive(coin));
+			Assert::IsFalse(entityManager.isAlive(projectile));
+			Assert::IsTrue(entityManager.isAlive(farSpike));
+		}
+
+		TEST_METHOD(InactiveEntitiesDoNotCollide)
+		{
+			EntityManager entityManager;
+			entityManager.setActiveArea({ { 0.f, 0.f }, { 100.f, 100.f } });
+			const EntityHandle player = entityManager.spawnEntity(entityUIDOf(EntityType::Player), { 200.f, 0.f });
+			entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 210.f, 0.f });
+
+			entityManager.updateAll(0.f);
+			entityManager.updateColisions();
+
+			Assert::IsTrue(entityManager.isAlive(player));
+		}
+
+		TEST_METHOD(BenchmarkUpdateAllAgainstVirtualDispatch)
+		{
+			constexpr int ENTITY_COUNT = 100000;
+			constexpr int TICK_COUNT = 120;
+			constexpr float DELTA_TIME = 1.f / 60.f;
+
+			EntityManager entityManager;
+			entityManager.reserve(ENTITY_COUNT);
+			std::vector<std::unique_ptr<BaselineEntity>> baseline;
+			baseline.reserve(ENTITY_COUNT);
+			for (int i = 0; i < ENTITY_COUNT; ++i)
+			{
+				const EntityHandle handle = entityManager.spawnEntity(entityUIDOf(EntityType::Projectile), benchmarkPosition(i));
+				baseline.push_back(std::make_unique<BaselineProjectile>(benchmarkPosition(i), entityManager.getVelocity(handle)));
+			}
+
+			using Clock = std::chrono::steady_clock;
+
+			const Clock::time_point baselineStart = Clock::now();
+			for (int tick = 0; tick < TICK_COUNT; ++tick)
+			{
+				for (const std::unique_ptr<BaselineEntity>& entity : baseline)
+					entity->update(DELTA_TIME);
+			}
+			const double baselineMs = std::chrono::duration<double, std::milli>(Clock::now() - baselineStart).count();
+
+			const Clock::time_point soaStart = Clock::now();
+			for (int tick = 0; tick < TICK_COUNT; ++tick)
+				entityManager.updateAll(DELTA_TIME);
+			const double soaMs = std::chrono::duration<double, std::milli>(Clock::now() - soaStart).count();
+
+			// Both paths must have simulated the same thing
+			for (int i = 0; i < ENTITY_COUNT; i += 997)
+				Assert::AreEqual(baseline[i]->getPosition().x, entityManager.getPositions()[i].x);
+
+			const std::string report = "updateAll x" + std::to_string(TICK_COUNT) + " on " + std::to_string(ENTITY_COUNT)
+				+ " entities: virtual " + std::to_string(baselineMs) + " ms, SoA " + std::to_string(soaMs) + " ms";
+			Logger::WriteMessage(report.c_str());
+		}
+	};
+}
@@ -0,0 +1,168 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "EntityManager.hpp"
+#include "JobSystem.hpp"
+#include "Simulation.hpp"
+#include "SpatialGrid.hpp"
+#include "StateHash.hpp"
+#include "StressScene.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	constexpr unsigned int JOB_TEST_THREAD_COUNT = 4;
+
+	// Dense: many update batches, many grid rows, many pairs
+	constexpr float CROWD_SPACING = 40.f;
+
+	std::uint64_t hashEntities(const EntityManager& entityManager)
+	{
+		StateHash hash;
+		entityManager.hashState(hash);
+		return hash.getValue();
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(JobSystemTests)
+	{
+	public:
+
+		TEST_METHOD(ParallelForCoversEveryIndexOnce)
+		{
+			JobSystem jobSystem(JOB_TEST_THREAD_COUNT);
+			Assert::AreEqual(JOB_TEST_THREAD_COUNT, jobSystem.getThreadCount());
+
+			std::vector<int> visits(100'003, 0);
+			jobSystem.parallelFor(visits.size(), 1000, [&visits](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t i = begin; i < end; ++i)
+					++visits[i];
+			});
+
+			for (int visitCount : visits)
+				Assert::AreEqual(1, visitCount);
+		}
+
+		TEST_METHOD(OneThreadRunsEverythingOnTheCaller)
+		{
+			JobSystem jobSystem(1);
+			const std::thread::id caller = std::this_thread::get_id();
+
+			std::size_t callCount = 0;
+			bool isOnCaller = true;
+			jobSystem.parallelFor(10'000, 16, [&](std::size_t begin, std::size_t end)
+			{
+				++callCount;
+				isOnCaller = isOnCaller && begin == 0 && end == 10'000 && std::this_thread::get_id() == caller;
+			});
+			Assert::AreEqual(std::size_t(1), callCount);
+
+			// Nothing can run it before wait()
+			bool hasRun = false;
+			const auto job = [&] { hasRun = true; isOnCaller = isOnCaller && std::this_thread::get_id() == caller; };
+			JobCounter counter;
+			jobSystem.run(counter, job);
+			Assert::IsFalse(hasRun);
+			jobSystem.wait(counter);
+
+			Assert::IsTrue(hasRun);
+			Assert::IsTrue(isOnCaller);
+		}
+
+		TEST_METHOD(NestedAndOverflowingJobsAllRun)
+		{
+			JobSystem jobSystem(JOB_TEST_THREAD_COUNT);
+			std::atomic<std::size_t> total{ 0 };
+
+			// More single-index jobs than a queue holds: the overflow runs inline
+			jobSystem.parallelFor(8, 1, [&](std::size_t, std::size_t)
+			{
+				jobSystem.parallelFor(3000, 1, [&](std::size_t begin, std::size_t end)
+				{
+					total.fetch_add(end - begin);
+				});
+			});
+
+			Assert::AreEqual(std::size_t(8 * 3000), total.load());
+		}
+
+		TEST_METHOD(ParallelBroadPhaseFindsTheSamePairs)
+		{
+			std::mt19937 rng(21);
+			std::vector<sf::FloatRect> hitboxes;
+			std::vector<std::uint32_t> indices;
+			for (std::uint32_t i = 0; i < 20'000; ++i)
+			{
+				hitboxes.emplace_back(sf::Vector2f(static_cast<float>(rng() % 10'000), static_cast<float>(rng() % 10'000)),
+					sf::Vector2f(static_cast<float>(8 + rng() % 120), static_cast<float>(8 + rng() % 120)));
+				if (i % 3 != 0)
+					indices.push_back(i);
+			}
+
+			SpatialGrid grid;
+			std::vector<SpatialGrid::Pair> pairs;
+			grid.findPairs(hitboxes, indices, pairs);
+
+			JobSystem jobSystem(JOB_TEST_THREAD_COUNT);
+			SpatialGrid parallelGrid;
+			std::vector<SpatialGrid::Pair> parallelPairs;
+			parallelGrid.findPairs(hitboxes, indices, parallelPairs, &jobSystem);
+
+			Assert::IsTrue(pairs.size() > 1000);
+			Assert::IsTrue(parallelPairs == pairs);
+		}
+
+		TEST_METHOD(ParallelTicksMatchSingleThreadedTicks)
+		{
+			JobSystem jobSystem(JOB_TEST_THREAD_COUNT);
+			EntityManager singleThreaded;
+			EntityManager parallel;
+			parallel.setJobSystem(&jobSystem);
+			spawnStressScene(singleThreaded, 8, 30'000, CROWD_SPACING);
+			spawnStressScene(parallel, 8, 30'000, CROWD_SPACING);
+
+			const sf::FloatRect activeArea({ 500.f, 500.f }, { 6000.f, 4000.f });
+			singleThreaded.setActiveArea(activeArea);
+			parallel.setActiveArea(activeArea);
+
+			for (int tick = 0; tick < 120; ++tick)
+			{
+				singleThreaded.updateAll(Simulation::TICK_DURATION);
+				singleThreaded.updateColisions();
+				parallel.updateAll(Simulation::TICK_DURATION);
+				parallel.updateColisions();
+				Assert::AreEqual(hashEntities(singleThreaded), hashEntities(parallel));
+			}
+			Assert::IsTrue(parallel.getEntityCount() < 30'000); // collisions did remove entities
+		}
+
+		TEST_METHOD(ParallelSimulationEndsInTheSameState)
+		{
+			JobSystem jobSystem(JOB_TEST_THREAD_COUNT);
+			Simulation singleThreaded({ 1920, 1080 }, 31);
+			Simulation parallel({ 1920, 1080 }, 31);
+			parallel.setJobSystem(&jobSystem);
+
+			std::mt19937 rng(31);
+			InputState input;
+			for (int tick = 0; tick < 60 * 60; ++tick)
+			{
+				if (tick % 20 == 0)
+					input.actions = static_cast<std::uint8_t>(rng() % 16);
+				singleThreaded.advance(input);
+				parallel.advance(input);
+			}
+
+			Assert::AreEqual(singleThreaded.computeStateHash(), parallel.computeStateHash());
+		}
+	};
+}
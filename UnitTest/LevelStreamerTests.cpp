@@ -0,0 +1,183 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "EntityManager.hpp"
+#include "LevelStreamer.hpp"
+#include "TextLevelSource.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	constexpr float CHUNK_WIDTH = 1000.f;
+	constexpr int CHUNK_COUNT = 3;
+	constexpr int ENTITIES_PER_CHUNK = 10;
+
+	// Spikes only: they never move, so entity positions only depend on streaming
+	std::filesystem::path writeTestLevel(const std::string& name)
+	{
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+		std::ofstream file(path, std::ios::trunc);
+		file << "# test level\nlevel 7\nchunkWidth " << CHUNK_WIDTH << "\n";
+		for (int chunk = 0; chunk < CHUNK_COUNT; ++chunk)
+		{
+			file << "chunk " << chunk << "\n";
+			for (int i = 0; i < ENTITIES_PER_CHUNK; ++i)
+				file << entityUIDOf(EntityType::Spike) << " " << i * 90 << " " << chunk * 100 + i << "\r\n";
+		}
+		return path;
+	}
+
+	sf::FloatRect cameraAt(float left)
+	{
+		return { { left, 0.f }, { 1920.f, 1080.f } };
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(LevelStreamerTests)
+	{
+	public:
+
+		TEST_METHOD(TextSourceReadsChunksIndependently)
+		{
+			TextLevelSource source(writeTestLevel("runner_text_source.txt"));
+
+			Assert::AreEqual(7, source.getLevelUID());
+			Assert::AreEqual(CHUNK_WIDTH, source.getChunkWidth());
+			Assert::AreEqual(CHUNK_COUNT, source.getChunkCount());
+
+			std::vector<LevelEntityRecord> entities;
+			source.readChunk(2, entities);
+			Assert::AreEqual(static_cast<std::size_t>(ENTITIES_PER_CHUNK), entities.size());
+			Assert::IsTrue(entities[3] == LevelEntityRecord{ entityUIDOf(EntityType::Spike), 270.f, 203.f });
+
+			source.readChunk(0, entities);
+			Assert::IsTrue(entities[0] == LevelEntityRecord{ entityUIDOf(EntityType::Spike), 0.f, 0.f });
+		}
+
+		TEST_METHOD(ChunksAreSpawnedAheadAndEvictedBehind)
+		{
+			TextLevelSource source(writeTestLevel("runner_streamer_finite.txt"));
+			EntityManager entityManager;
+			LevelStreamer streamer;
+			streamer.start(source, false);
+
+			// Camera [0, 1920]: chunks starting before 2920 are spawned (0, 1, 2)
+			streamer.update(cameraAt(0.f), entityManager);
+			Assert::AreEqual(3, streamer.getSpawnedChunkCount());
+			Assert::AreEqual(static_cast<std::size_t>(3 * ENTITIES_PER_CHUNK), entityManager.getEntityCount());
+
+			// Chunks are placed at index * chunkWidth
+			const std::vector<sf::Vector2f>& positions = entityManager.getPositions();
+			Assert::IsTrue(std::find(positions.begin(), positions.end(), sf::Vector2f(2000.f + 270.f, 203.f)) != positions.end());
+
+			// Camera [2500, 4420]: chunks 0 and 1 are entirely behind
+			streamer.update(cameraAt(2500.f), entityManager);
+			Assert::AreEqual(static_cast<std::size_t>(1), streamer.getLoadedChunkCount());
+			Assert::AreEqual(static_cast<std::size_t>(ENTITIES_PER_CHUNK), entityManager.getEntityCount());
+		}
+
+		TEST_METHOD(InfiniteLevelKeepsMemoryFlat)
+		{
+			TextLevelSource source(writeTestLevel("runner_streamer_infinite.txt"));
+			EntityManager entityManager;
+			LevelStreamer streamer;
+			streamer.start(source, true);
+
+			// About an hour of scrolling at full speed (900 px/s)
+			std::size_t maxEntityCount = 0;
+			std::uint32_t maxSlot = 0;
+			for (float cameraLeft = 0.f; cameraLeft < 3.3e6f; cameraLeft += 250.f)
+			{
+				streamer.update(cameraAt(cameraLeft), entityManager);
+				maxEntityCount = std::max(maxEntityCount, entityManager.getEntityCount());
+				for (std::size_t i = 0; i < entityManager.getEntityCount(); ++i)
+					maxSlot = std::max(maxSlot, entityManager.getHandle(i).index);
+			}
+
+			Assert::IsTrue(streamer.getSpawnedChunkCount() > 3000);
+			Assert::IsTrue(streamer.getLoadedChunkCount() <= 5);
+
+			// Then many short runs, each ended by a death: the restart drops whatever the loader prefetched
+			entityManager.clear();
+			streamer.start(source, true);
+			streamer.update(cameraAt(0.f), entityManager);
+			const std::vector<sf::Vector2f> firstPositions = entityManager.getPositions();
+			for (int death = 0; death < 500; ++death)
+			{
+				const float deathX = static_cast<float>(death % 7) * 1700.f + 250.f;
+				for (float cameraLeft = 250.f; cameraLeft < deathX; cameraLeft += 250.f)
+				{
+					streamer.update(cameraAt(cameraLeft), entityManager);
+					maxEntityCount = std::max(maxEntityCount, entityManager.getEntityCount());
+					for (std::size_t i = 0; i < entityManager.getEntityCount(); ++i)
+						maxSlot = std::max(maxSlot, entityManager.getHandle(i).index);
+				}
+
+				entityManager.clear();
+				streamer.start(source, true);
+				streamer.update(cameraAt(0.f), entityManager);
+				Assert::IsTrue(entityManager.getPositions() == firstPositions);
+			}
+
+			Assert::IsTrue(streamer.getLoadedChunkCount() <= 5);
+			Assert::IsTrue(maxEntityCount <= static_cast<std::size_t>(5 * ENTITIES_PER_CHUNK));
+			// Slots of despawned chunks are reused instead of growing the arrays
+			Assert::IsTrue(maxSlot < static_cast<std::uint32_t>(6 * ENTITIES_PER_CHUNK));
+		}
+
+		TEST_METHOD(SpawningDoesNotDependOnLoaderTiming)
+		{
+			TextLevelSource firstSource(writeTestLevel("runner_streamer_first.txt"));
+			TextLevelSource secondSource(writeTestLevel("runner_streamer_second.txt"));
+			EntityManager firstEntities;
+			EntityManager secondEntities;
+			LevelStreamer firstStreamer;
+			LevelStreamer secondStreamer;
+			firstStreamer.start(firstSource, true);
+			secondStreamer.start(secondSource, true);
+
+			for (float cameraLeft = 0.f; cameraLeft < 50000.f; cameraLeft += 333.f)
+			{
+				firstStreamer.update(cameraAt(cameraLeft), firstEntities);
+				if (static_cast<int>(cameraLeft) % 7 == 0)
+					std::this_thread::yield();
+				secondStreamer.update(cameraAt(cameraLeft), secondEntities);
+
+				Assert::AreEqual(firstStreamer.getSpawnedChunkCount(), secondStreamer.getSpawnedChunkCount());
+				Assert::IsTrue(firstEntities.getPositions() == secondEntities.getPositions());
+			}
+		}
+
+		TEST_METHOD(MalformedLevelThrows)
+		{
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "runner_malformed.txt";
+			{
+				std::ofstream file(path, std::ios::trunc);
+				file << "level 1\nchunkWidth 100\nchunk 0\n1 abc 3\n";
+			}
+
+			TextLevelSource source(path);
+			std::vector<LevelEntityRecord> entities;
+			bool hasThrown = false;
+			try
+			{
+				source.readChunk(0, entities);
+			}
+			catch (const std::runtime_error&)
+			{
+				hasThrown = true;
+			}
+			Assert::IsTrue(hasThrown);
+		}
+	};
+}
@@ -0,0 +1,255 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#ifdef RUNNER_PROFILING
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Profiler.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	// Earlier tests leave events in this thread's buffer: skip them
+	ProfileReader makeReaderAfterPastEvents()
+	{
+		ProfileReader reader;
+		reader.readNewEvents([](const ProfileBuffer&, const ProfileEvent&) {});
+		return reader;
+	}
+
+	std::vector<ProfileEvent> readEventsOf(ProfileReader& reader, const ProfileBuffer& buffer)
+	{
+		std::vector<ProfileEvent> events;
+		reader.readNewEvents([&](const ProfileBuffer& eventBuffer, const ProfileEvent& event)
+		{
+			if (&eventBuffer == &buffer)
+				events.push_back(event);
+		});
+		return events;
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(ProfilerTests)
+	{
+	public:
+
+		TEST_METHOD(ScopedTimerRecordsItsZone)
+		{
+			ProfileReader reader = makeReaderAfterPastEvents();
+			{
+				PROFILE_SCOPE(ProfileZone::UI);
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			}
+
+			const std::vector<ProfileEvent> events = readEventsOf(reader, Profiler::getThreadBuffer());
+			Assert::AreEqual(std::size_t(1), events.size());
+			Assert::IsTrue(events[0].zone == ProfileZone::UI);
+			Assert::IsTrue(events[0].end - events[0].start >= 2'000'000);
+		}
+
+		TEST_METHOD(EachThreadWritesItsOwnBuffer)
+		{
+			constexpr int THREAD_COUNT = 4;
+			constexpr int EVENT_COUNT = 100;
+
+			// Buffers of earlier tests' threads are reused: only this test's events count
+			ProfileReader reader = makeReaderAfterPastEvents();
+
+			std::array<const ProfileBuffer*, THREAD_COUNT> buffers{};
+			std::atomic<int> runningCount{ 0 };
+			std::vector<std::thread> threads;
+			for (int t = 0; t < THREAD_COUNT; ++t)
+			{
+				threads.emplace_back([&buffers, &runningCount, t]
+				{
+					PROFILE_THREAD_NAME("Profiler test");
+					for (int i = 0; i < EVENT_COUNT; ++i)
+					{
+						PROFILE_SCOPE(ProfileZone::Collision);
+					}
+					buffers[t] = &Profiler::getThreadBuffer();
+
+					// All alive at once, otherwise a thread could take the buffer of one that exited
+					runningCount.fetch_add(1);
+					while (runningCount.load() < THREAD_COUNT)
+						std::this_thread::yield();
+				});
+			}
+			for (std::thread& thread : threads)
+				thread.join();
+
+			// The threads are gone, their buffers stay readable
+			std::array<int, THREAD_COUNT> eventCounts{};
+			reader.readNewEvents([&](const ProfileBuffer& buffer, const ProfileEvent&)
+			{
+				for (int t = 0; t < THREAD_COUNT; ++t)
+					eventCounts[t] += &buffer == buffers[t];
+			});
+
+			for (int t = 0; t < THREAD_COUNT; ++t)
+			{
+				for (int other = 0; other < t; ++other)
+					Assert::IsTrue(buffers[t]->getThreadIndex() != buffers[other]->getThreadIndex());
+				Assert::AreEqual(std::string("Profiler test"), std::string(buffers[t]->getThreadName()));
+				Assert::AreEqual(EVENT_COUNT, eventCounts[t]);
+			}
+		}
+
+		TEST_METHOD(RestartedThreadsReuseTheirBuffer)
+		{
+			const auto countBuffers = []
+			{
+				std::size_t count = 0;
+				for (const ProfileBuffer* buffer = Profiler::getFirstBuffer(); buffer; buffer = buffer->getNext())
+					++count;
+				return count;
+			};
+
+			// Like the level loader, restarted on every death
+			const std::size_t bufferCount = countBuffers();
+			for (int restart = 0; restart < 200; ++restart)
+			{
+				std::thread thread([]
+				{
+					PROFILE_THREAD_NAME("Restarted thread");
+					PROFILE_SCOPE(ProfileZone::LevelStreaming);
+				});
+				thread.join();
+			}
+
+			Assert::IsTrue(countBuffers() <= bufferCount + 1);
+		}
+
+		TEST_METHOD(OverwrittenEventsAreCountedAsDropped)
+		{
+			constexpr std::uint64_t EXTRA_EVENTS = 10;
+
+			const ProfileBuffer* buffer = nullptr;
+			std::thread writer([&buffer]
+			{
+				ProfileBuffer& threadBuffer = Profiler::getThreadBuffer();
+				for (std::uint64_t i = 0; i < ProfileBuffer::CAPACITY + EXTRA_EVENTS; ++i)
+					threadBuffer.push({ i, i + 1, ProfileZone::Draw });
+				buffer = &threadBuffer;
+			});
+			writer.join();
+
+			ProfileReader reader;
+			const std::vector<ProfileEvent> events = readEventsOf(reader, *buffer);
+
+			Assert::AreEqual(std::size_t(ProfileBuffer::CAPACITY), events.size());
+			Assert::AreEqual(EXTRA_EVENTS, events.front().start); // the oldest events are the ones lost
+			Assert::AreEqual(ProfileBuffer::CAPACITY + EXTRA_EVENTS - 1, events.back().start);
+			// At least: the main thread may have wrapped its buffer in earlier tests
+			Assert::IsTrue(reader.getDroppedEventCount() >= EXTRA_EVENTS);
+		}
+
+		TEST_METHOD(ConcurrentReadsNeverSeeTornEvents)
+		{
+			// Before the writer starts: a reused buffer holds older events that would fail the check
+			ProfileReader reader = makeReaderAfterPastEvents();
+			std::atomic<const ProfileBuffer*> buffer{ nullptr };
+			std::atomic<bool> isDone{ false };
+			std::thread writer([&]
+			{
+				ProfileBuffer& threadBuffer = Profiler::getThreadBuffer();
+				buffer.store(&threadBuffer);
+				for (std::uint64_t i = 0; i < ProfileBuffer::CAPACITY * 8; ++i)
+					threadBuffer.push({ i, i * 3, static_cast<ProfileZone>(i % PROFILE_ZONE_COUNT) });
+				isDone.store(true);
+			});
+
+			while (!buffer.load())
+				std::this_thread::yield();
+
+			std::uint64_t readCount = 0;
+			bool isConsistent = true;
+			auto check = [&](const ProfileBuffer& eventBuffer, const ProfileEvent& event)
+			{
+				if (&eventBuffer != buffer.load())
+					return;
+				++readCount;
+				isConsistent = isConsistent && event.end == event.start * 3
+					&& event.zone == static_cast<ProfileZone>(event.start % PROFILE_ZONE_COUNT);
+			};
+			while (!isDone.load())
+				reader.readNewEvents(check);
+			writer.join();
+			reader.readNewEvents(check);
+
+			Assert::IsTrue(isConsistent);
+			Assert::IsTrue(readCount > 0);
+		}
+
+		TEST_METHOD(HistorySumsEachFrame)
+		{
+			ProfileHistory history;
+			history.endFrame();
+
+			ProfileBuffer& buffer = Profiler::getThreadBuffer();
+			buffer.push({ 0, 2'000'000, ProfileZone::Update });
+			buffer.push({ 5'000'000, 8'000'000, ProfileZone::Update });
+			buffer.push({ 8'000'000, 9'000'000, ProfileZone::Draw });
+			history.endFrame();
+
+			const ProfileHistory::Frame newest = history.getFrame(ProfileHistory::HISTORY_SIZE - 1);
+			Assert::AreEqual(5.0, static_cast<double>(newest[static_cast<std::size_t>(ProfileZone::Update)]), 1e-4);
+			Assert::AreEqual(1.0, static_cast<double>(newest[static_cast<std::size_t>(ProfileZone::Draw)]), 1e-4);
+			Assert::AreEqual(0.0, static_cast<double>(newest[static_cast<std::size_t>(ProfileZone::UI)]), 1e-4);
+
+			// Rolls until that frame is the oldest one; the first frame, with the earlier tests' events, is gone
+			for (std::size_t frame = 1; frame < ProfileHistory::HISTORY_SIZE; ++frame)
+				history.endFrame();
+			Assert::AreEqual(5.0, static_cast<double>(history.getFrame(0)[static_cast<std::size_t>(ProfileZone::Update)]), 1e-4);
+			Assert::AreEqual(0.0, static_cast<double>(history.getFrame(1)[static_cast<std::size_t>(ProfileZone::Update)]), 1e-4);
+			Assert::AreEqual(5.0 / ProfileHistory::HISTORY_SIZE, static_cast<double>(history.getAverage(ProfileZone::Update)), 1e-4);
+		}
+
+		TEST_METHOD(ChromeTraceIsAJsonEventArray)
+		{
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "runner_trace.json";
+			{
+				ChromeTraceWriter writer;
+				writer.open(path);
+				Profiler::getThreadBuffer().push({ 1'500, 4'000, ProfileZone::Collision });
+				writer.flush();
+				Profiler::getThreadBuffer().push({ 123'456'789'000, 123'456'790'000, ProfileZone::LevelStreaming });
+				writer.close();
+				writer.close();
+			}
+
+			std::ifstream file(path);
+			const std::string trace((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+			Assert::AreEqual(std::size_t(0), trace.find("{\"traceEvents\":["));
+			Assert::AreEqual(std::string("]}\n"), trace.substr(trace.size() - 3));
+			Assert::IsTrue(trace.find("{\"name\":\"Collision\",\"cat\":\"runner\",\"ph\":\"X\",\"ts\":1.500,\"dur\":2.500,") != std::string::npos);
+			// Long sessions: timestamps stay plain decimals
+			Assert::IsTrue(trace.find("\"ts\":123456789.000,\"dur\":1.000,") != std::string::npos);
+			Assert::IsTrue(trace.find("e+") == std::string::npos);
+			Assert::IsTrue(trace.find(",]") == std::string::npos);
+
+			int depth = 0;
+			for (char c : trace)
+			{
+				depth += (c == '{' || c == '[') - (c == '}' || c == ']');
+				Assert::IsTrue(depth >= 0);
+			}
+			Assert::AreEqual(0, depth);
+		}
+	};
+}
+
+#endif
@@ -0,0 +1,133 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include "AtlasPacker.hpp"
+#include "EntityManager.hpp"
+#include "RenderBatcher.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	const sf::FloatRect VIEW_RECT({ 0.f, 0.f }, { 1920.f, 1080.f });
+
+	std::array<sf::FloatRect, ENTITY_TYPE_COUNT> testTextureRects()
+	{
+		std::array<sf::FloatRect, ENTITY_TYPE_COUNT> textureRects;
+		for (std::size_t type = 0; type < ENTITY_TYPE_COUNT; ++type)
+			textureRects[type] = sf::FloatRect({ static_cast<float>(type) * 100.f, 0.f }, { 64.f, 64.f });
+		return textureRects;
+	}
+
+	const RenderBatch* findBatch(const RenderBatcher& renderBatcher, int layer, BlendLayer blend)
+	{
+		for (const RenderBatch& batch : renderBatcher.getBatches())
+		{
+			if (batch.layer == layer && batch.blend == blend)
+				return &batch;
+		}
+		return nullptr;
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(RenderBatcherTests)
+	{
+	public:
+
+		TEST_METHOD(OneQuadOfTwoTrianglesPerVisibleEntity)
+		{
+			EntityManager entityManager;
+			entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 100.f, 200.f });
+
+			RenderBatcher renderBatcher;
+			renderBatcher.setTextureRects(testTextureRects());
+			renderBatcher.build(entityManager, VIEW_RECT, 1.f);
+
+			const RenderBatch* batch = findBatch(renderBatcher, 1, BlendLayer::Alpha);
+			Assert::IsNotNull(batch);
+			Assert::AreEqual(static_cast<std::size_t>(6), batch->vertices.size());
+
+			// Triangles (top-left, top-right, bottom-left) and (bottom-left, top-right, bottom-right)
+			const sf::Vector2f expectedPositions[6] = { { 100.f, 200.f }, { 164.f, 200.f }, { 100.f, 264.f },
+				{ 100.f, 264.f }, { 164.f, 200.f }, { 164.f, 264.f } };
+			const sf::Vector2f expectedTexCoords[6] = { { 100.f, 0.f }, { 164.f, 0.f }, { 100.f, 64.f },
+				{ 100.f, 64.f }, { 164.f, 0.f }, { 164.f, 64.f } };
+			for (std::size_t i = 0; i < 6; ++i)
+			{
+				Assert::IsTrue(batch->vertices[i].position == expectedPositions[i]);
+				Assert::IsTrue(batch->vertices[i].texCoords == expectedTexCoords[i]);
+			}
+		}
+
+		TEST_METHOD(EntitiesOutsideTheViewAreCulled)
+		{
+			EntityManager entityManager;
+			entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 100.f, 100.f });
+			entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 5000.f, 100.f });
+			entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { -200.f, 100.f });
+
+			RenderBatcher renderBatcher;
+			renderBatcher.build(entityManager, VIEW_RECT, 1.f);
+
+			Assert::AreEqual(static_cast<std::size_t>(2), renderBatcher.getStats().culledEntities);
+			Assert::AreEqual(static_cast<std::size_t>(6), renderBatcher.getStats().vertexCount);
+		}
+
+		TEST_METHOD(OneDrawCallPerLayerAndBlendMode)
+		{
+			EntityManager entityManager;
+			for (int i = 0; i < 50; ++i)
+			{
+				entityManager.spawnEntity(entityUIDOf(EntityType::Spike), { 10.f * i, 100.f });
+				entityManager.spawnEntity(entityUIDOf(EntityType::MovingEnemy), { 10.f * i, 300.f });
+				entityManager.spawnEntity(entityUIDOf(EntityType::Projectile), { 10.f * i, 500.f });
+				entityManager.spawnEntity(entityUIDOf(EntityType::Collectible), { 10.f * i, 700.f });
+			}
+
+			RenderBatcher renderBatcher;
+			renderBatcher.build(entityManager, VIEW_RECT, 1.f);
+
+			// Collectibles (layer 0), spikes + moving enemies (layer 1, alpha), projectiles (layer 1, additive)
+			Assert::AreEqual(static_cast<std::size_t>(3), renderBatcher.getStats().drawCalls);
+			Assert::AreEqual(static_cast<std::size_t>(200 * 6), renderBatcher.getStats().vertexCount);
+			Assert::AreEqual(static_cast<std::size_t>(100 * 6), findBatch(renderBatcher, 1, BlendLayer::Alpha)->vertices.size());
+			Assert::AreEqual(static_cast<std::size_t>(50 * 6), findBatch(renderBatcher, 1, BlendLayer::Additive)->vertices.size());
+
+			const std::vector<RenderBatch>& batches = renderBatcher.getBatches();
+			for (std::size_t i = 1; i < batches.size(); ++i)
+				Assert::IsTrue(batches[i - 1].layer <= batches[i].layer);
+		}
+
+		TEST_METHOD(VerticesAreInterpolated)
+		{
+			EntityManager entityManager;
+			entityManager.spawnEntity(entityUIDOf(EntityType::Projectile), { 1000.f, 100.f });
+			entityManager.updateAll(0.1f); // moves by -60 on x
+
+			RenderBatcher renderBatcher;
+			renderBatcher.build(entityManager, VIEW_RECT, 0.5f);
+
+			const RenderBatch* batch = findBatch(renderBatcher, 1, BlendLayer::Additive);
+			Assert::AreEqual(970.f, batch->vertices[0].position.x);
+		}
+
+		TEST_METHOD(AtlasRegionsDoNotOverlap)
+		{
+			const std::vector<sf::Vector2u> sizes = { { 64, 64 }, { 32, 16 }, { 128, 32 }, { 300, 200 }, { 16, 16 }, { 64, 64 } };
+			const AtlasLayout layout = packAtlas(sizes, 512, 1);
+
+			Assert::AreEqual(sizes.size(), layout.regions.size());
+			for (std::size_t a = 0; a < sizes.size(); ++a)
+			{
+				const sf::IntRect& region = layout.regions[a];
+				Assert::IsTrue(region.size == static_cast<sf::Vector2i>(sizes[a]));
+				Assert::IsTrue(region.position.x + region.size.x <= static_cast<int>(layout.size.x));
+				Assert::IsTrue(region.position.y + region.size.y <= static_cast<int>(layout.size.y));
+				for (std::size_t b = a + 1; b < sizes.size(); ++b)
+					Assert::IsFalse(region.findIntersection(layout.regions[b]).has_value());
+			}
+		}
+	};
+}
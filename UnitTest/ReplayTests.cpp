@@ -0,0 +1,123 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include "InputRecording.hpp"
+#include "Replay.hpp"
+#include "Simulation.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	const sf::Vector2u REPLAY_RESOLUTION = { 1920, 1080 };
+
+	// Held directions for a few dozen ticks, like a player would
+	InputRecording makeRecording(std::uint32_t seed, std::size_t tickCount)
+	{
+		std::mt19937 rng(seed);
+		InputRecording recording;
+		recording.seed = seed;
+		InputState input;
+		while (recording.inputs.size() < tickCount)
+		{
+			input.actions = static_cast<std::uint8_t>(rng() % 16);
+			recording.inputs.insert(recording.inputs.end(), std::min<std::size_t>(10 + rng() % 50, tickCount - recording.inputs.size()), input);
+		}
+		return recording;
+	}
+
+	// What Game::run() does while recording
+	std::uint64_t playLive(const InputRecording& recording)
+	{
+		Simulation simulation(REPLAY_RESOLUTION, recording.seed);
+		for (const InputState& input : recording.inputs)
+			simulation.advance(input);
+		return simulation.computeStateHash();
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(ReplayTests)
+	{
+	public:
+
+		TEST_METHOD(RecordingRoundTripsThroughCompactFile)
+		{
+			InputRecording recording = makeRecording(5, 60 * 60);
+			recording.finalStateHash = 0x0123456789ABCDEFull;
+			recording.levelUID = 4;
+			recording.isInfinite = true;
+
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "runner_recording.rrec";
+			saveInputRecording(recording, path);
+
+			Assert::IsTrue(loadInputRecording(path) == recording);
+			// A minute of held inputs: about two bytes per input change
+			Assert::IsTrue(std::filesystem::file_size(path) < recording.inputs.size() / 10);
+		}
+
+		TEST_METHOD(ReplayEndsInTheRecordedState)
+		{
+			InputRecording recording = makeRecording(77, 60 * 60 * 2);
+			recording.finalStateHash = playLive(recording);
+
+			const ReplayResult result = replayRecording(recording, REPLAY_RESOLUTION, true);
+
+			Assert::AreEqual(recording.finalStateHash, result.finalStateHash);
+			Assert::IsTrue(result.matches(recording));
+			Assert::AreEqual(recording.inputs.size(), result.tickMilliseconds.size());
+			Assert::IsTrue(result.runCount > 1); // deaths and restarts are replayed too
+		}
+
+		TEST_METHOD(DifferentInputsEndInADifferentState)
+		{
+			InputRecording recording;
+			recording.seed = 77;
+			recording.inputs.resize(60 * 30);
+			recording.finalStateHash = playLive(recording);
+
+			// Half a second down from the middle of the screen, nowhere near the edges
+			for (std::size_t tick = 60; tick < 90; ++tick)
+				recording.inputs[tick].setPressed(InputAction::Down, true);
+			const ReplayResult result = replayRecording(recording, REPLAY_RESOLUTION, false);
+
+			Assert::IsFalse(result.matches(recording));
+		}
+
+		TEST_METHOD(TickTimePercentiles)
+		{
+			std::vector<double> tickMilliseconds;
+			for (int i = 1; i <= 1000; ++i)
+				tickMilliseconds.push_back(static_cast<double>(1001 - i));
+
+			const TickTimeSummary summary = summarizeTickTimes(tickMilliseconds);
+			Assert::AreEqual(500.0, summary.p50);
+			Assert::AreEqual(990.0, summary.p99);
+			Assert::AreEqual(1000.0, summary.max);
+		}
+
+		TEST_METHOD(CorruptedRecordingThrows)
+		{
+			const std::filesystem::path path = std::filesystem::temp_directory_path() / "runner_corrupted.rrec";
+			saveInputRecording(makeRecording(1, 600), path);
+			std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+			bool hasThrown = false;
+			try
+			{
+				loadInputRecording(path);
+			}
+			catch (const std::runtime_error&)
+			{
+				hasThrown = true;
+			}
+			Assert::IsTrue(hasThrown);
+		}
+	};
+}
@@ -0,0 +1,92 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include "FixedTimestep.hpp"
+#include "Simulation.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	InputState inputForTick(std::uint64_t tick)
+	{
+		InputState input;
+		input.setPressed(InputAction::Up, tick % 120 < 40);
+		input.setPressed(InputAction::Down, tick % 120 >= 80);
+		input.setPressed(InputAction::Right, tick % 50 < 10);
+		return input;
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(SimulationTests)
+	{
+	public:
+
+		TEST_METHOD(FixedTimestepRunsWholeTicksAndKeepsRemainder)
+		{
+			FixedTimestep timestep(0.01f, 5);
+
+			Assert::AreEqual(0, timestep.advance(0.005f));
+			Assert::AreEqual(1, timestep.advance(0.008f));
+			Assert::AreEqual(0.3f, timestep.getAlpha(), 0.01f);
+		}
+
+		TEST_METHOD(FixedTimestepCapsCatchUpSteps)
+		{
+			FixedTimestep timestep(0.01f, 5);
+
+			Assert::AreEqual(5, timestep.advance(1.f));
+			// The backlog is dropped instead of being simulated over the next frames
+			Assert::AreEqual(1, timestep.advance(0.f));
+			Assert::AreEqual(0, timestep.advance(0.f));
+		}
+
+		TEST_METHOD(SameSeedAndInputsGiveSameState)
+		{
+			Simulation first({ 1920, 1080 }, 1234);
+			Simulation second({ 1920, 1080 }, 1234);
+
+			for (std::uint64_t tick = 0; tick < 600; ++tick)
+			{
+				first.tick(inputForTick(tick));
+				second.tick(inputForTick(tick));
+			}
+
+			Assert::AreEqual(first.getEntityManager().getEntityCount(), second.getEntityManager().getEntityCount());
+			Assert::IsTrue(first.getEntityManager().getPositions() == second.getEntityManager().getPositions());
+			Assert::IsTrue(first.getCameraCenter() == second.getCameraCenter());
+		}
+
+		TEST_METHOD(PreviousStateIsKeptForInterpolation)
+		{
+			Simulation simulation({ 1920, 1080 }, 1);
+			simulation.tick({});
+			const sf::Vector2f cameraBefore = simulation.getCameraCenter();
+			simulation.tick({});
+
+			Assert::IsTrue(simulation.getPreviousCameraCenter() == cameraBefore);
+			Assert::IsTrue(simulation.getCameraCenter().x > cameraBefore.x);
+
+			const EntityManager& entityManager = simulation.getEntityManager();
+			const EntityHandle player = simulation.getPlayer().getHandle();
+			Assert::IsTrue(entityManager.getPosition(player).x > entityManager.getPreviousPositions()[0].x);
+		}
+
+		TEST_METHOD(HeadlessSoakKeepsEntityCountBounded)
+		{
+			Simulation simulation({ 1920, 1080 }, 99);
+			std::size_t maxEntityCount = 0;
+			for (std::uint64_t tick = 0; tick < 60 * 60 * 5; ++tick)
+			{
+				simulation.tick(inputForTick(tick));
+				if (simulation.isOver())
+					simulation.reset();
+				maxEntityCount = std::max(maxEntityCount, simulation.getEntityManager().getEntityCount());
+			}
+
+			Assert::IsTrue(maxEntityCount < 64);
+		}
+	};
+}
@@ -0,0 +1,113 @@
+#include "pch.h"
+#include "CppUnitTest.h"
+
+#include <random>
+#include <vector>
+
+#include "Entity.hpp"
+#include "SpatialGrid.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace
+{
+	std::vector<sf::FloatRect> randomScene(unsigned int seed, std::size_t count, sf::Vector2f area, float maxSize)
+	{
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<float> xDistribution(0.f, area.x);
+		std::uniform_real_distribution<float> yDistribution(0.f, area.y);
+		std::uniform_real_distribution<float> sizeDistribution(1.f, maxSize);
+
+		std::vector<sf::FloatRect> hitboxes;
+		hitboxes.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+			hitboxes.emplace_back(sf::Vector2f(xDistribution(rng), yDistribution(rng)), sf::Vector2f(sizeDistribution(rng), sizeDistribution(rng)));
+		return hitboxes;
+	}
+
+	std::vector<SpatialGrid::Pair> bruteForcePairs(const std::vector<sf::FloatRect>& hitboxes, const std::vector<std::uint32_t>& indices)
+	{
+		std::vector<SpatialGrid::Pair> pairs;
+		for (std::size_t a = 0; a < indices.size(); ++a)
+			for (std::size_t b = a + 1; b < indices.size(); ++b)
+				if (isColliding(hitboxes[indices[a]], hitboxes[indices[b]]))
+					pairs.emplace_back(indices[a], indices[b]);
+		return pairs;
+	}
+}
+
+namespace UnitTest
+{
+	TEST_CLASS(SpatialGridTests)
+	{
+	public:
+
+		TEST_METHOD(MatchesBruteForceOnRandomScenes)
+		{
+			constexpr std::size_t HITBOX_COUNT = 10000;
+			SpatialGrid spatialGrid({ 1920, 1080 });
+			std::vector<SpatialGrid::Pair> pairs;
+
+			for (unsigned int seed = 1; seed <= 4; ++seed)
+			{
+				// Small, mixed and screen-sized hitboxes, crowded and sparse scenes
+				const float maxSize = seed % 2 == 0 ? 40.f : 300.f;
+				const sf::Vector2f area = seed <= 2 ? sf::Vector2f(1920.f, 1080.f) : sf::Vector2f(20000.f, 3000.f);
+				const std::vector<sf::FloatRect> hitboxes = randomScene(seed, HITBOX_COUNT, area, maxSize);
+
+				std::vector<std::uint32_t> indices;
+				for (std::uint32_t i = 0; i < hitboxes.size(); ++i)
+				{
+					if (i % 3 != 0)
+						indices.push_back(i);
+				}
+
+				spatialGrid.findPairs(hitboxes, indices, pairs);
+				const std::vector<SpatialGrid::Pair> expected = bruteForcePairs(hitboxes, indices);
+
+				Assert::IsFalse(expected.empty());
+				Assert::IsTrue(pairs == expected, L"Broad phase pairs differ from brute force");
+			}
+		}
+
+		TEST_METHOD(PairOrderIsDeterministic)
+		{
+			const std::vector<sf::FloatRect> hitboxes = randomScene(42, 2000, { 1920.f, 1080.f }, 120.f);
+			std::vector<std::uint32_t> indices(hitboxes.size());
+			for (std::uint32_t i = 0; i < indices.size(); ++i)
+				indices[i] = i;
+
+			SpatialGrid firstGrid;
+			SpatialGrid secondGrid;
+			std::vector<SpatialGrid::Pair> firstPairs;
+			std::vector<SpatialGrid::Pair> secondPairs;
+			firstGrid.findPairs(hitboxes, indices, firstPairs);
+			secondGrid.findPairs(randomScene(7, 500, { 800.f, 600.f }, 50.f), std::vector<std::uint32_t>{ 0, 1, 2 }, secondPairs);
+			secondGrid.findPairs(hitboxes, indices, secondPairs);
+
+			Assert::IsTrue(firstPairs == secondPairs);
+			for (const SpatialGrid::Pair& pair : firstPairs)
+				Assert::IsTrue(pair.first < pair.second);
+		}
+
+		TEST_METHOD(FarAwayHitboxesDoNotBlowUpTheGrid)
+		{
+			// 1e15: more cells than an unsigned int can count, well inside the default active area
+			for (const float farAway : { 1.0e7f, 1.0e15f })
+			{
+				const std::vector<sf::FloatRect> hitboxes = {
+					{ { 0.f, 0.f }, { 10.f, 10.f } },
+					{ { 5.f, 5.f }, { 10.f, 10.f } },
+					{ { farAway, farAway }, { 10.f, 10.f } },
+				};
+				SpatialGrid spatialGrid;
+				std::vector<SpatialGrid::Pair> pairs;
+				spatialGrid.findPairs(hitboxes, { 0, 1, 2 }, pairs);
+
+				Assert::AreEqual(static_cast<std::size_t>(1), pairs.size());
+				Assert::AreEqual(0u, pairs[0].first);
+				Assert::AreEqual(1u, pairs[0].second);
+			}
+		}
+	};
+}